@@ -20,6 +20,7 @@
 #include "symbolic/object.h"
 #include "symbolic/proposition.h"
 #include "symbolic/state.h"
+#include "symbolic/undo_log.h"
 #include "symbolic/utils/parameter_generator.h"
 
 namespace VAL {
@@ -57,6 +58,34 @@ class Action {
     return static_cast<bool>(Apply_(arguments, state));
   }
 
+  bool Apply(const std::vector<Object>& arguments, LoggedState* state) const {
+    return static_cast<bool>(ApplyLogged_(arguments, state));
+  }
+
+  /**
+   * Applies the action to the state in place.
+   *
+   * Starts a new frame in the undo log and records every proposition flipped
+   * by the action, including axiom side effects, so that Undo() can restore
+   * the previous state without copying it. Changes made later with the same
+   * log, such as derived predicate updates, belong to the same frame.
+   *
+   * @param arguments Action arguments.
+   * @param state State to modify.
+   * @param log Undo log.
+   * @returns Whether the state changed.
+   */
+  bool ApplyInPlace(const std::vector<Object>& arguments, State* state,
+                    UndoLog* log) const;
+
+  /**
+   * Reverts the last frame of the undo log started by ApplyInPlace().
+   *
+   * @param state State modified by ApplyInPlace().
+   * @param log Undo log.
+   */
+  static void Undo(State* state, UndoLog* log) { log->Undo(state); }
+
   PartialState Apply(const PartialState& state,
                      const std::vector<Object>& arguments) const;
 
@@ -77,8 +106,24 @@ class Action {
   const std::vector<Object>& parameters() const { return parameters_; }
 
   const ParameterGenerator& parameter_generator() const { return param_gen_; }
+  ParameterGenerator& parameter_generator() { return param_gen_; }
+
+  /**
+   * Copies the parameter generator and restricts it with the static literals
+   * at the top level of the preconditions, evaluated against
+   * Pddl::static_state().
+   *
+   * A parameter in a positive static literal can only take the values that
+   * appear in the same position of a static proposition. A parameter in a
+   * negative unary static literal can't take the values of static
+   * propositions. The result only holds for states with the same static
+   * propositions, so it is only used to ground the actions, and
+   * parameter_generator() is left unchanged.
+   */
+  ParameterGenerator CreateStaticParameterGenerator() const;
 
   const Formula& preconditions() const { return Preconditions_; }
+  Formula& preconditions() { return Preconditions_; }
 
   const VAL::effect_lists* postconditions() const;
 
@@ -89,6 +134,16 @@ class Action {
   static std::pair<Action, std::vector<Object>> Parse(
       const Pddl& pddl, const std::string& action_call);
 
+  /**
+   * Throws std::invalid_argument if the arguments don't match the number and
+   * types of the action parameters.
+   *
+   * @param args Arguments parsed from the action call.
+   * @param action_call Action call, used for the error message.
+   */
+  void CheckArguments(const std::vector<Object>& args,
+                      const std::string& action_call) const;
+
   friend bool operator<(const Action& lhs, const Action& rhs) {
     return lhs.name() < rhs.name();
   }
@@ -109,6 +164,7 @@ class Action {
   Formula Preconditions_;
   std::function<int(const std::vector<Object>&, State*)> Apply_;
   std::function<int(const std::vector<Object>&, PartialState*)> ApplyPartial_;
+  std::function<int(const std::vector<Object>&, LoggedState*)> ApplyLogged_;
 };
 
 }  // namespace symbolic
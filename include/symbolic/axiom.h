@@ -63,6 +63,22 @@ class Axiom : public Action {
   PartialState Apply(const PartialState& state) const;
   int Apply(PartialState* state) const;
 
+  /**
+   * Iterate over all argument combinations and apply the implication whenever
+   * the context is valid, recording the changes in the state's undo log.
+   */
+  bool Apply(LoggedState* state) const;
+
+  /**
+   * Apply the implication only for the argument combinations whose context
+   * proposition is the given one, if the context is valid.
+   *
+   * @param prop Proposition with the context predicate.
+   * @param state State to modify.
+   * @returns Whether the state changed.
+   */
+  bool ApplyContext(const PropositionBase& prop, LoggedState* state) const;
+
   /**
    * Predicate used in the axiom context.
    */
@@ -88,6 +104,9 @@ class Axiom : public Action {
   std::vector<std::vector<Object>> arguments_;
   SignedProposition context_;
   std::string formula_;
+
+  // Axiom parameter index of each context argument, or -1 for constants.
+  std::vector<int> idx_context_params_;
 };
 
 }  // namespace symbolic
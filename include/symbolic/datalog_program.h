@@ -0,0 +1,191 @@
+/**
+ * datalog_program.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_DATALOG_PROGRAM_H_
+#define SYMBOLIC_DATALOG_PROGRAM_H_
+
+#include <string>         // std::string
+#include <unordered_map>  // std::unordered_map
+#include <unordered_set>  // std::unordered_set
+#include <vector>         // std::vector
+
+#include "symbolic/derived_predicate.h"
+#include "symbolic/object.h"
+#include "symbolic/proposition.h"
+#include "symbolic/state.h"
+#include "symbolic/undo_log.h"
+
+namespace symbolic {
+
+class Pddl;
+
+/**
+ * Derived predicates compiled into stratified Datalog rules.
+ *
+ * Each derived predicate body is expanded into conjunctive rules, which are
+ * evaluated stratum by stratum with semi-naive iteration: after the first
+ * round, a recursive rule is only joined against the atoms derived in the
+ * previous round. Negated derived predicates must belong to lower strata.
+ *
+ * Derived predicates can also be maintained incrementally with
+ * delete-and-rederive: given a state whose derived predicates are up to date
+ * and the changes made to it since, only the derived atoms that depend on the
+ * changes are deleted, rederived, or inserted. Atoms are looked up in the
+ * state directly, so the cost of an update depends on the changes and the
+ * atoms joined with them rather than on the size of the state.
+ *
+ * Bodies with universal quantifiers and programs that can't be stratified
+ * aren't compiled, in which case is_compiled() is false and the derived
+ * predicates should be applied with DerivedPredicate::Apply().
+ */
+class DatalogProgram {
+ public:
+  /**
+   * Body literal of a rule.
+   */
+  struct Literal {
+    enum class Type { kProposition, kEquality, kType };
+
+    Type type;
+    bool is_pos;
+    std::string name_predicate;
+
+    /**
+     * Rule variable index of each argument, or -1 for constants.
+     */
+    std::vector<int> idx_vars;
+
+    /**
+     * Argument objects, which are only used for the constants.
+     */
+    std::vector<Object> arguments;
+
+    /**
+     * Index of the derived predicate, or -1 if the predicate isn't derived.
+     */
+    int idx_derived;
+  };
+
+  /**
+   * Conjunctive rule deriving its head from the body literals.
+   */
+  struct Rule {
+    size_t idx_head;
+
+    /**
+     * Head parameters followed by the existential variables of the body.
+     */
+    std::vector<Object> variables;
+    size_t num_head_vars;
+
+    std::vector<Literal> body;
+  };
+
+  DatalogProgram() = default;
+
+  DatalogProgram(const Pddl& pddl,
+                 const std::vector<DerivedPredicate>& predicates);
+
+  /**
+   * Whether all the derived predicates could be compiled and stratified.
+   */
+  bool is_compiled() const { return is_compiled_; }
+
+  const std::vector<Rule>& rules() const { return rules_; }
+
+  /**
+   * Derived predicate names.
+   */
+  const std::vector<std::string>& predicates() const { return predicates_; }
+
+  /**
+   * Derived predicate indices grouped by stratum, from lowest to highest.
+   */
+  const std::vector<std::vector<size_t>>& strata() const { return strata_; }
+
+  /**
+   * Recomputes the derived predicates of the state.
+   *
+   * @returns Whether the state changed.
+   */
+  bool Apply(State* state) const;
+
+  /**
+   * Recomputes the derived predicates in place and records the flipped
+   * propositions in the current frame of the undo log.
+   */
+  bool Apply(State* state, UndoLog* log) const;
+
+  /**
+   * Updates the derived predicates of the state after the given changes.
+   *
+   * @param state State whose derived predicates were up to date before the
+   *              changes were made to it.
+   * @param changes Changes made to the non-derived propositions.
+   * @returns Whether the derived predicates changed.
+   */
+  bool Update(State* state, const std::vector<UndoLog::Entry>& changes) const;
+
+  /**
+   * Updates the derived predicates after the changes recorded in the current
+   * frame of the undo log, and records the derived changes in the same frame.
+   */
+  bool Update(State* state, UndoLog* log) const;
+
+ private:
+  class Database;
+  class RuleJoin;
+
+  bool Stratify();
+
+  /**
+   * Derives the atoms of the stratum from scratch.
+   */
+  void EvaluateStratum(size_t idx_stratum, Database* db) const;
+
+  /**
+   * Updates the atoms of the stratum after the changes of the lower strata.
+   */
+  void UpdateStratum(size_t idx_stratum, Database* db) const;
+
+  /**
+   * Inserts the consequences of the new atoms of the stratum until the
+   * fixpoint, joining the recursive literals with the atoms of the last round.
+   */
+  void Propagate(size_t idx_stratum, std::vector<Proposition>&& frontier,
+                 Database* db) const;
+
+  template <typename T>
+  bool ApplyProgram(T* state) const;
+
+  template <typename T>
+  bool UpdateProgram(T* state,
+                     const std::vector<UndoLog::Entry>& changes) const;
+
+  template <typename T>
+  bool ApplyChanges(const Database& db, T* state) const;
+
+  const Pddl* pddl_ = nullptr;
+  bool is_compiled_ = false;
+
+  std::vector<Rule> rules_;
+  std::vector<std::string> predicates_;
+  std::unordered_map<std::string, size_t> idx_predicates_;
+
+  // Body and head predicates, which are indexed during evaluation.
+  std::unordered_set<std::string> relations_;
+
+  std::vector<size_t> idx_strata_;
+  std::vector<std::vector<size_t>> strata_;
+  std::vector<std::vector<size_t>> stratum_rules_;
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_DATALOG_PROGRAM_H_
@@ -38,6 +38,13 @@ class DerivedPredicate : public Action {
 
   static bool Apply(const std::vector<DerivedPredicate>& predicates, State* state);
 
+  /**
+   * Applies the derived predicates in place and records the flipped
+   * propositions in the current frame of the undo log.
+   */
+  static bool Apply(const std::vector<DerivedPredicate>& predicates,
+                    State* state, UndoLog* log);
+
  private:
   const VAL::derivation_rule* symbol_;
 };
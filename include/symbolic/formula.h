@@ -11,9 +11,11 @@
 #define SYMBOLIC_FORMULA_H_
 
 #include <functional>  // std::function
+#include <memory>      // std::shared_ptr
 #include <optional>    // std::optional
 #include <ostream>     // std::ostream
 #include <set>         // std::set
+#include <string>      // std::string
 #include <vector>      // std::vector
 
 #include "symbolic/object.h"
@@ -24,6 +26,7 @@
 namespace VAL {
 
 class goal;
+class simple_goal;
 
 }  // namespace VAL
 
@@ -33,8 +36,109 @@ class Pddl;
 
 class Action;
 
+/**
+ * Flat conjunction of positive and negative literals.
+ *
+ * Pure conjunctions (the common shape of STRIPS preconditions and goals) are
+ * evaluated in a single loop over contiguous literal and argument slot arrays
+ * instead of through a tree of nested std::functions.
+ */
+class LiteralConjunction {
+ public:
+  enum class Type { kProposition, kEquality, kType };
+
+  struct Literal {
+    const std::string* name_predicate;
+    size_t predicate_hash;
+    Type type;
+    bool is_pos;
+    size_t idx_source;  // Position of the literal in the formula.
+    size_t idx_slot;   // Index of the first argument slot.
+    size_t num_slots;  // Number of proposition arguments.
+  };
+
+  LiteralConjunction() = default;
+
+  /**
+   * Compiles the goal into a literal conjunction.
+   *
+   * @param pddl Pddl object.
+   * @param symbol Goal symbol.
+   * @param parameters Formula parameters.
+   * @returns Literal conjunction, or nullopt if the goal is not a (possibly
+   *          nested) conjunction of positive and negative literals.
+   */
+  static std::optional<LiteralConjunction> Create(
+      const Pddl& pddl, const VAL::goal* symbol,
+      const std::vector<Object>& parameters);
+
+  bool operator()(const State& state,
+                  const std::vector<Object>& arguments) const {
+    for (const Literal& literal : literals_) {
+      if (Evaluate(literal, state, arguments) != literal.is_pos) return false;
+    }
+    return true;
+  }
+
+  /**
+   * Evaluates the literal's proposition, ignoring the literal's sign.
+   */
+  bool Evaluate(const Literal& literal, const State& state,
+                const std::vector<Object>& arguments) const;
+
+  /**
+   * Returns the proposition arguments of the literal.
+   */
+  std::vector<Object> Arguments(const Literal& literal,
+                                const std::vector<Object>& arguments) const;
+
+  /**
+   * Returns the object in the given argument slot.
+   */
+  const Object& Slot(size_t idx_slot,
+                     const std::vector<Object>& arguments) const {
+    const int idx_param = slot_params_[idx_slot];
+    return idx_param < 0 ? slot_objects_[idx_slot] : arguments[idx_param];
+  }
+
+  /**
+   * Formula parameter index of each argument slot, or -1 for constants.
+   */
+  const std::vector<int>& slot_params() const { return slot_params_; }
+
+  /**
+   * Literals in evaluation order.
+   */
+  const std::vector<Literal>& literals() const { return literals_; }
+
+  /**
+   * Changes the evaluation order of the literals.
+   *
+   * @param order Source indices of the literals in the new evaluation order.
+   */
+  void Reorder(const std::vector<size_t>& order);
+
+  size_t size() const { return literals_.size(); }
+
+ private:
+  void AddLiteral(const Pddl& pddl, const VAL::simple_goal* symbol,
+                  const std::vector<Object>& parameters, bool is_pos);
+
+  std::vector<Literal> literals_;
+  std::vector<int> slot_params_;
+  std::vector<Object> slot_objects_;
+};
+
 class Formula {
  public:
+  /**
+   * Per-conjunct evaluation counts collected in profiling mode.
+   */
+  struct ConjunctStatistics {
+    size_t num_evaluated = 0;
+    size_t num_failed = 0;
+  };
+
   Formula() = default;
 
   Formula(const Pddl& pddl, const VAL::goal* symbol)
@@ -47,16 +151,90 @@ class Formula {
 
   bool operator()(const State& state,
                   const std::vector<Object>& arguments) const {
-    return P_(state, arguments);
+    if (profile_) return EvaluateProfiled(state, arguments);
+    if (literals_) return (*literals_)(state, arguments);
+    for (const Conjunct& conjunct : conjuncts_) {
+      if (!conjunct.P(state, arguments)) return false;
+    }
+    return true;
   };
 
-  bool operator()(const State& state) const { return P_(state, {}); };
+  bool operator()(const State& state) const { return (*this)(state, {}); };
 
   std::optional<bool> operator()(const PartialState& state,
                                  const std::vector<Object>& arguments) const;
 
   std::optional<bool> operator()(const PartialState& state) const;
 
+  /**
+   * Compiled literal conjunction, or nullptr if the formula is not a pure
+   * conjunction of literals.
+   */
+  const LiteralConjunction* literal_conjunction() const {
+    return literals_ ? &*literals_ : nullptr;
+  }
+
+  /**
+   * Number of top-level conjuncts. Nested conjunctions of literals are
+   * flattened, and a formula that isn't a conjunction has one conjunct.
+   */
+  size_t num_conjuncts() const {
+    return literals_ ? literals_->size() : conjuncts_.size();
+  }
+
+  /**
+   * Evaluates every top-level conjunct without short-circuiting.
+   *
+   * @param state Current state.
+   * @param arguments Formula arguments.
+   * @param satisfied Optional output vector that is filled with the
+   *                  satisfaction of each conjunct in source order.
+   * @returns Number of unsatisfied conjuncts.
+   */
+  size_t CountUnsatisfied(const State& state,
+                          const std::vector<Object>& arguments,
+                          std::vector<bool>* satisfied = nullptr) const;
+  size_t CountUnsatisfied(const State& state,
+                          std::vector<bool>* satisfied = nullptr) const {
+    return CountUnsatisfied(state, {}, satisfied);
+  }
+
+  /**
+   * Evaluation order of the top-level conjuncts as source indices.
+   */
+  std::vector<size_t> conjunct_order() const;
+
+  /**
+   * Changes the evaluation order of the top-level conjuncts.
+   *
+   * Since evaluation short-circuits on the first false conjunct, putting the
+   * most selective conjuncts first reduces the evaluation work.
+   *
+   * @param order Source indices of the conjuncts in the new evaluation order.
+   */
+  void ReorderConjuncts(const std::vector<size_t>& order);
+
+  /**
+   * Reorders the conjuncts by decreasing failure rate observed in profiling
+   * mode. Conjuncts that were never evaluated keep their relative order after
+   * the profiled ones.
+   */
+  void ReorderConjunctsByFailureRate();
+
+  /**
+   * Enables or disables profiling mode, which counts how often each conjunct
+   * is evaluated and how often it fails. Enabling resets the counts. Copies of
+   * the formula share the same counts.
+   */
+  void set_profiling(bool profiling);
+
+  bool profiling() const { return profile_ != nullptr; }
+
+  /**
+   * Profiling counts of the conjuncts in source order.
+   */
+  std::vector<ConjunctStatistics> conjunct_statistics() const;
+
   const std::string& to_string() const { return str_formula_; }
 
   friend std::ostream& operator<<(std::ostream& os, const Formula& F);
@@ -70,10 +248,26 @@ class Formula {
                             const std::vector<Object>& prop_params);
 
  private:
+  struct Conjunct {
+    std::function<bool(const State& state,
+                       const std::vector<Object>& arguments)>
+        P;
+    size_t idx_source;
+  };
+
+  class Profile;
+
+  bool EvaluateProfiled(const State& state,
+                        const std::vector<Object>& arguments) const;
+
   const VAL::goal* symbol_ = nullptr;
 
-  std::function<bool(const State& state, const std::vector<Object>& arguments)>
-      P_;
+  std::optional<LiteralConjunction> literals_;
+
+  // Conjuncts in evaluation order if the formula isn't a literal conjunction.
+  std::vector<Conjunct> conjuncts_;
+
+  std::shared_ptr<Profile> profile_;
 
   std::function<bool(const PartialState& state,
                      const std::vector<Object>& arguments)>
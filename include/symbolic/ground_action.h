@@ -0,0 +1,220 @@
+/**
+ * ground_action.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_GROUND_ACTION_H_
+#define SYMBOLIC_GROUND_ACTION_H_
+
+#include <ostream>  // std::ostream
+#include <string>   // std::string
+#include <vector>   // std::vector
+
+#include "symbolic/action.h"
+#include "symbolic/object.h"
+#include "symbolic/state.h"
+
+namespace symbolic {
+
+class Pddl;
+
+/**
+ * Conjunction of literals of a ground formula.
+ *
+ * All propositions are represented by their StateIndex indices.
+ */
+struct GroundConjunction {
+  std::vector<size_t> pos;
+  std::vector<size_t> neg;
+
+  /**
+   * Evaluates whether all of the literals are satisfied in the indexed state.
+   */
+  bool IsSatisfied(const StateIndex::IndexedState& state) const;
+};
+
+/**
+ * Conditional effect of a ground action.
+ *
+ * All propositions are represented by their StateIndex indices.
+ */
+struct GroundConditionalEffect {
+  std::vector<size_t> pre_pos;
+  std::vector<size_t> pre_neg;
+  std::vector<size_t> add_effects;
+  std::vector<size_t> del_effects;
+};
+
+/**
+ * Action with fixed arguments whose preconditions and effects are compiled
+ * into sorted lists of StateIndex proposition indices.
+ *
+ * Preconditions are a single conjunction of literals. Actions with disjunctive
+ * preconditions are split into one ground action per disjunct. Equality, type,
+ * and static literals are evaluated during grounding and do not appear in the
+ * preconditions.
+ *
+ * Axiom side effects and derived predicates are not compiled into the ground
+ * action.
+ */
+class GroundAction {
+ public:
+  GroundAction() = default;
+
+  GroundAction(size_t id, const Action& action, std::vector<Object> arguments)
+      : id_(id), action_(&action), arguments_(std::move(arguments)) {}
+
+  /**
+   * Grounds all the actions of the pddl.
+   *
+   * Ground actions are ordered by action and then by parameter generator index,
+   * and the id of each ground action is its index in the returned vector.
+   *
+   * @param pddl Pddl object.
+   * @returns Vector of ground actions.
+   */
+  static std::vector<GroundAction> Ground(const Pddl& pddl);
+
+  /**
+   * Selects a subset of ground actions and renumbers their ids to their
+   * indices in the returned vector.
+   *
+   * @param actions Ground actions.
+   * @param ids Ids of the ground actions to keep in increasing order.
+   * @returns Vector of selected ground actions.
+   */
+  static std::vector<GroundAction> Select(
+      const std::vector<GroundAction>& actions, const std::vector<size_t>& ids);
+
+  /**
+   * Grounds the goal into a disjunction of literal conjunctions, with the same
+   * simplifications as the ground action preconditions.
+   *
+   * @param pddl Pddl object.
+   * @returns Conjunctions of the disjunction, which is empty if the goal is
+   *          always false.
+   */
+  static std::vector<GroundConjunction> GroundGoal(const Pddl& pddl);
+
+  /**
+   * Evaluates whether any conjunction of the ground goal is satisfied in the
+   * indexed state.
+   *
+   * @param goal Ground goal from GroundGoal().
+   * @param state Indexed state.
+   */
+  static bool IsGoal(const std::vector<GroundConjunction>& goal,
+                     const StateIndex::IndexedState& state);
+
+  /**
+   * Indexes the consistent state with its derived predicates, since
+   * Apply(const Pddl&, StateIndex::IndexedState*) updates them incrementally.
+   *
+   * @param pddl Pddl object.
+   * @param state Root state of a search.
+   * @returns Indexed root state.
+   */
+  static StateIndex::IndexedState GetRoot(const Pddl& pddl,
+                                          const State& state);
+
+  /**
+   * Whether the pddl has no axioms or derived predicates, in which case
+   * Apply(StateIndex::IndexedState*) gives the same successor as
+   * Pddl::ApplyAction().
+   */
+  static bool IsDerivationFree(const Pddl& pddl);
+
+  /**
+   * Evaluates whether the preconditions are satisfied in the indexed state.
+   */
+  bool IsApplicable(const StateIndex::IndexedState& state) const;
+
+  /**
+   * Applies the effects to the indexed state, with the same result as
+   * Action::Apply().
+   *
+   * Conditional effects are evaluated in the state before the action is
+   * applied. If that could change the result, as when a conditional effect
+   * writes a proposition read by a condition, the lifted action is applied
+   * instead.
+   */
+  void Apply(StateIndex::IndexedState* state) const;
+
+  /**
+   * Applies the action to the indexed state along with the axioms and derived
+   * predicates of the pddl, with the same result as Pddl::ApplyAction().
+   *
+   * Without axioms or derived predicates, the indexed state is updated
+   * directly. Otherwise, the lifted action is applied to the unindexed state.
+   */
+  void Apply(const Pddl& pddl, StateIndex::IndexedState* state) const;
+
+  /**
+   * Stable integer id of the ground action.
+   */
+  size_t id() const { return id_; }
+
+  const Action& action() const { return *action_; }
+
+  const std::vector<Object>& arguments() const { return arguments_; }
+
+  /**
+   * Positive precondition propositions.
+   */
+  const std::vector<size_t>& pre_pos() const { return pre_pos_; }
+
+  /**
+   * Negative precondition propositions.
+   */
+  const std::vector<size_t>& pre_neg() const { return pre_neg_; }
+
+  /**
+   * Unconditional add effects. These are disjoint from the delete effects,
+   * since the lifted action applies its effects in order and the last effect
+   * on a proposition wins.
+   */
+  const std::vector<size_t>& add_effects() const { return add_effects_; }
+
+  /**
+   * Unconditional delete effects.
+   */
+  const std::vector<size_t>& del_effects() const { return del_effects_; }
+
+  const std::vector<GroundConditionalEffect>& conditional_effects() const {
+    return conditional_effects_;
+  }
+
+  /**
+   * Whether the result of the effects depends on the order in which the lifted
+   * action applies them, in which case Apply() falls back to the lifted action.
+   */
+  bool is_order_dependent() const { return is_order_dependent_; }
+
+  /**
+   * Action call string in the form of `"action(obj_a, obj_b)"`.
+   */
+  std::string to_string() const { return action_->to_string(arguments_); }
+
+  friend std::ostream& operator<<(std::ostream& os, const GroundAction& action);
+
+ private:
+  size_t id_ = 0;
+  const Action* action_ = nullptr;
+  const StateIndex* state_index_ = nullptr;
+  std::vector<Object> arguments_;
+
+  std::vector<size_t> pre_pos_;
+  std::vector<size_t> pre_neg_;
+  std::vector<size_t> add_effects_;
+  std::vector<size_t> del_effects_;
+  std::vector<GroundConditionalEffect> conditional_effects_;
+  bool is_order_dependent_ = false;
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_GROUND_ACTION_H_
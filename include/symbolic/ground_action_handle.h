@@ -0,0 +1,47 @@
+/**
+ * ground_action_handle.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_GROUND_ACTION_HANDLE_H_
+#define SYMBOLIC_GROUND_ACTION_HANDLE_H_
+
+#include <vector>  // std::vector
+
+#include "symbolic/object.h"
+
+namespace symbolic {
+
+/**
+ * Action call resolved against a Pddl instance.
+ *
+ * Handles are created once with Pddl::ResolveAction() and can then be applied
+ * or validated any number of times without parsing the call string again.
+ * They remain valid as long as the actions of the Pddl instance don't change.
+ */
+struct GroundActionHandle {
+  /**
+   * Index of the action in Pddl::actions().
+   */
+  size_t idx_action;
+
+  std::vector<Object> arguments;
+
+  friend bool operator==(const GroundActionHandle& lhs,
+                         const GroundActionHandle& rhs) {
+    return lhs.idx_action == rhs.idx_action && lhs.arguments == rhs.arguments;
+  }
+
+  friend bool operator!=(const GroundActionHandle& lhs,
+                         const GroundActionHandle& rhs) {
+    return !(lhs == rhs);
+  }
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_GROUND_ACTION_HANDLE_H_
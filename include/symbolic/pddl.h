@@ -20,11 +20,18 @@
 
 #include "symbolic/action.h"
 #include "symbolic/axiom.h"
+#include "symbolic/datalog_program.h"
 #include "symbolic/derived_predicate.h"
 #include "symbolic/formula.h"
+#include "symbolic/ground_action.h"
+#include "symbolic/ground_action_handle.h"
 #include "symbolic/object.h"
 #include "symbolic/predicate.h"
 #include "symbolic/proposition.h"
+#include "symbolic/reachability.h"
+#include "symbolic/relevance_index.h"
+#include "symbolic/successor_generator.h"
+#include "symbolic/utils/thread_pool.h"
 
 namespace VAL {
 
@@ -40,6 +47,7 @@ namespace symbolic {
 class Pddl {
  public:
   using ObjectTypeMap = std::unordered_map<std::string, std::vector<Object>>;
+  using ObjectNameMap = std::unordered_map<std::string, Object>;
   using AxiomContextMap =
       std::unordered_map<std::string, std::vector<std::weak_ptr<Axiom>>>;
 
@@ -88,6 +96,29 @@ class Pddl {
    * @seepython{symbolic.Pddl,next_state}
    */
   State NextState(const State& state, const std::string& action_call) const;
+  State NextState(const State& state, const GroundActionHandle& action) const;
+
+  /**
+   * Apply ground actions to a batch of states in parallel.
+   *
+   * Each state is paired with the ground action at the same position. The
+   * actions must have been grounded with Ground(). As in NextState(), the
+   * preconditions are not checked and the next states include derived
+   * predicates.
+   *
+   * @param states Current states.
+   * @param actions Ground action ids, one per state.
+   * @param pool Thread pool that applies the actions.
+   * @returns Next states in the order of the inputs.
+   *
+   * @seepython{symbolic.Pddl,next_states}
+   */
+  std::vector<State> NextStates(const std::vector<State>& states,
+                                const std::vector<size_t>& actions,
+                                ThreadPool* pool) const;
+  StateIndex::IndexedStates NextStates(
+      Eigen::Ref<const StateIndex::IndexedStates> states,
+      const std::vector<size_t>& actions, ThreadPool* pool) const;
 
   /**
    * Execute a sequence of actions from the given state.
@@ -102,12 +133,75 @@ class Pddl {
    * @seepython{symbolic.Pddl.execute}
    */
   State ApplyActions(const State& state, const std::vector<std::string>& action_calls) const;
+  State ApplyActions(const State& state,
+                     const std::vector<GroundActionHandle>& actions) const;
+
+  /**
+   * Resolve an action call into a handle that can be applied or validated
+   * repeatedly without parsing the string again.
+   *
+   * @param action_call Action call in the form of `"action(obj_a, obj_b)"`.
+   * @returns Handle with the action index and arguments.
+   *
+   * @seepython{symbolic.Pddl,resolve_action}
+   */
+  GroundActionHandle ResolveAction(const std::string& action_call) const;
+  std::vector<GroundActionHandle> ResolveActions(
+      const std::vector<std::string>& action_calls) const;
 
   /**
    * Apply the derived predicates to the given state.
    */
   State DerivedState(const State& state) const;
 
+  /**
+   * Recomputes the derived predicates of the state in place.
+   *
+   * Uses the compiled Datalog program when all the derived predicates could
+   * be stratified, and otherwise iterates DerivedPredicate::Apply() until the
+   * derived predicates converge.
+   *
+   * @returns Whether the state changed.
+   */
+  bool ApplyDerivedPredicates(State* state) const;
+
+  /**
+   * Recomputes the derived predicates in place and records the flipped
+   * propositions in the current frame of the undo log.
+   */
+  bool ApplyDerivedPredicates(State* state, UndoLog* log) const;
+
+  /**
+   * Updates the derived predicates of the state after the given changes to
+   * its other propositions, only revisiting the derived atoms that depend on
+   * them.
+   *
+   * The derived predicates must have been up to date before the changes. If
+   * they couldn't be compiled, they are recomputed instead.
+   *
+   * @returns Whether the state changed.
+   */
+  bool UpdateDerivedPredicates(
+      State* state, const std::vector<UndoLog::Entry>& changes) const;
+
+  /**
+   * Updates the derived predicates after the changes recorded in the current
+   * frame of the undo log, and records the derived changes in the same frame.
+   */
+  bool UpdateDerivedPredicates(State* state, UndoLog* log) const;
+
+  /**
+   * Applies the action to the state and updates its derived predicates
+   * incrementally from the action's changes.
+   *
+   * The action preconditions are not checked, and the derived predicates of
+   * the given state must be up to date.
+   *
+   * @returns Whether the state changed.
+   */
+  bool ApplyAction(const Action& action, const std::vector<Object>& arguments,
+                   State* state) const;
+
   /**
    * Applies the axioms to the given state.
    *
@@ -138,6 +232,8 @@ class Pddl {
    * @seepython{symbolic.Pddl,is_valid_action}
    */
   bool IsValidAction(const State& state, const std::string& action) const;
+  bool IsValidAction(const State& state,
+                     const GroundActionHandle& action) const;
 
   /**
    * Evaluates whether the state satisfies the axioms.
@@ -172,6 +268,28 @@ class Pddl {
   bool IsValidTuple(const std::set<std::string>& state,
                     const std::string& action_call,
                     const std::set<std::string>& next_state) const;
+  bool IsValidTuple(const State& state, const GroundActionHandle& action,
+                    const State& next_state) const;
+
+  /**
+   * Evaluate whether a batch of (s, a, s') tuples are valid in parallel.
+   *
+   * The actions are ground action ids, and the actions must have been grounded
+   * with Ground().
+   *
+   * @returns Validity of each tuple in the order of the inputs.
+   *
+   * @seepython{symbolic.Pddl,is_valid_tuples}
+   */
+  std::vector<bool> IsValidTuples(const std::vector<State>& states,
+                                  const std::vector<size_t>& actions,
+                                  const std::vector<State>& next_states,
+                                  ThreadPool* pool) const;
+  Eigen::Array<bool, Eigen::Dynamic, 1> IsValidTuples(
+      Eigen::Ref<const StateIndex::IndexedStates> states,
+      const std::vector<size_t>& actions,
+      Eigen::Ref<const StateIndex::IndexedStates> next_states,
+      ThreadPool* pool) const;
 
   /**
    * Evaluate whether the goal is satisfied at the given state.
@@ -179,10 +297,31 @@ class Pddl {
   bool IsGoalSatisfied(const State& state) const { return goal_(state); }
   bool IsGoalSatisfied(const std::set<std::string>& state) const;
 
+  /**
+   * Count the number of unsatisfied top-level goal conjuncts.
+   *
+   * @param state Current state.
+   * @param satisfied Optional output vector that is filled with the
+   *                  satisfaction of each goal conjunct in source order.
+   * @returns Number of unsatisfied goal conjuncts.
+   *
+   * @seepython{symbolic.Pddl,count_unsatisfied_goals}
+   */
+  size_t CountUnsatisfiedGoals(const State& state,
+                               std::vector<bool>* satisfied = nullptr) const {
+    return goal_.CountUnsatisfied(state, satisfied);
+  }
+  size_t CountUnsatisfiedGoals(const std::set<std::string>& state,
+                               std::vector<bool>* satisfied = nullptr) const;
+
   /**
    * Evaluate whether the given action skeleton is valid and satisfies the goal.
+   *
+   * The derived predicates of the initial state are evaluated first.
    */
   bool IsValidPlan(const std::vector<std::string>& action_skeleton) const;
+  bool IsValidPlan(
+      const std::vector<GroundActionHandle>& action_skeleton) const;
 
   /**
    * List the valid arguments for an action from the given state.
@@ -192,6 +331,19 @@ class Pddl {
   std::vector<std::vector<std::string>> ListValidArguments(
       const std::set<std::string>& state, const std::string& action_name) const;
 
+  /**
+   * List the valid arguments for an action in parallel.
+   *
+   * The parameter combinations are split into ranges that are evaluated on
+   * the thread pool. The arguments are returned in the same order as the
+   * serial version.
+   *
+   * @seepython{symbolic.Pddl,list_valid_arguments}
+   */
+  std::vector<std::vector<Object>> ListValidArguments(const State& state,
+                                                      const Action& action,
+                                                      ThreadPool* pool) const;
+
   /**
    * List the valid actions from the given state.
    */
@@ -199,6 +351,135 @@ class Pddl {
   std::vector<std::string> ListValidActions(
       const std::set<std::string>& state) const;
 
+  /**
+   * List the valid actions in parallel.
+   *
+   * The parameter combinations of all the actions are split into ranges that
+   * are evaluated on the thread pool. The actions are returned in the same
+   * order as the serial version.
+   *
+   * @seepython{symbolic.Pddl,list_valid_actions}
+   */
+  std::vector<std::string> ListValidActions(const State& state,
+                                            ThreadPool* pool) const;
+  std::vector<std::string> ListValidActions(const std::set<std::string>& state,
+                                            ThreadPool* pool) const;
+
+  /**
+   * Enables or disables profiling of the action preconditions and goal.
+   *
+   * In profiling mode, each formula counts how often its top-level conjuncts
+   * are evaluated and how often they fail. Enabling resets the counts.
+   *
+   * @param profiling Whether to profile formula evaluation.
+   *
+   * @seepython{symbolic.Pddl,set_formula_profiling}
+   */
+  void set_formula_profiling(bool profiling);
+
+  /**
+   * Reorders the conjuncts of the profiled action preconditions and goal so
+   * that the conjuncts with the highest observed failure rate are evaluated
+   * first.
+   *
+   * @seepython{symbolic.Pddl,reorder_conjuncts}
+   */
+  void ReorderConjuncts();
+
+  /**
+   * Saves the conjunct order of the action preconditions.
+   *
+   * Each line of the file contains an action name followed by the source
+   * indices of its precondition conjuncts in evaluation order.
+   *
+   * @param filename Path of the output file.
+   *
+   * @seepython{symbolic.Pddl,save_conjunct_order}
+   */
+  void SaveConjunctOrder(const std::string& filename) const;
+
+  /**
+   * Loads the conjunct order of the action preconditions saved with
+   * SaveConjunctOrder().
+   *
+   * @param filename Path of the input file.
+   *
+   * @seepython{symbolic.Pddl,load_conjunct_order}
+   */
+  void LoadConjunctOrder(const std::string& filename);
+
+  /**
+   * Grounds the actions into a table of ground actions.
+   *
+   * Each ground action stores its preconditions and effects as StateIndex
+   * proposition indices, and its id is its index in the table. Grounding is
+   * done once, and calling this function again returns the existing table.
+   *
+   * @returns Ground action table.
+   *
+   * @seepython{symbolic.Pddl,ground}
+   */
+  const std::vector<GroundAction>& Ground();
+
+  /**
+   * Whether the actions have been grounded with Ground().
+   */
+  bool is_grounded() const { return is_grounded_; }
+
+  /**
+   * Ground action table, which is empty if the actions have not been grounded.
+   */
+  const std::vector<GroundAction>& ground_actions() const {
+    return ground_actions_;
+  }
+
+  /**
+   * Successor generator over the ground action table, which is empty if the
+   * actions have not been grounded.
+   */
+  const SuccessorGenerator& successor_generator() const {
+    return successor_generator_;
+  }
+
+  /**
+   * Indexes from predicates to the actions that add, delete or require them.
+   * Once the actions are grounded with Ground(), ground propositions are also
+   * indexed to the ground actions.
+   *
+   * @seepython{symbolic.Pddl,relevance_index}
+   */
+  const RelevanceIndex& relevance_index() const { return relevance_index_; }
+
+  /**
+   * Returns the ground actions applicable in the given state.
+   *
+   * The actions must have been grounded with Ground(). Derived predicates in
+   * the state are expected to be up to date.
+   *
+   * @param state Current state.
+   * @returns Ids of the applicable ground actions in increasing order.
+   *
+   * @seepython{symbolic.Pddl,list_applicable_ground_actions}
+   */
+  std::vector<size_t> ListApplicableGroundActions(const State& state) const;
+
+  /**
+   * Computes the propositions and ground actions reachable from the initial
+   * state under the delete relaxation. Grounds the actions if necessary.
+   *
+   * With pruning, the unreachable ground actions are removed from the ground
+   * action table, whose ids are renumbered, and each action's parameter domains
+   * are restricted to the arguments of its reachable ground actions. Searches
+   * from states that are not reachable from the initial state may then miss
+   * actions.
+   *
+   * @param prune Whether to prune the unreachable ground actions.
+   * @returns Reachable propositions and ground actions, with ids after pruning.
+   *
+   * @seepython{symbolic.Pddl,analyze_reachability}
+   */
+  Reachability AnalyzeReachability(bool prune = false);
+
   void AddObject(const std::string& name, const std::string& type);
   void RemoveObject(const std::string& name);
 
@@ -223,13 +504,31 @@ class Pddl {
    * Initial state for planning.
    */
   const State& initial_state() const { return initial_state_; }
-  void set_initial_state(State&& state) { initial_state_ = std::move(state); }
+
+  /**
+   * Sets the initial state and updates the static propositions.
+   *
+   * Ground actions are pruned with the static propositions, so they are
+   * cleared if the static propositions change and must be grounded again with
+   * Ground().
+   */
+  void set_initial_state(State&& state);
 
   const ObjectTypeMap& object_map() const { return object_map_; }
 
   const std::vector<Object>& constants() const { return constants_; }
   const std::vector<Object>& objects() const { return objects_; }
 
+  /**
+   * Finds an object or constant by name in constant time.
+   *
+   * @returns Pointer to the object, or nullptr if it doesn't exist.
+   */
+  const Object* FindObject(const std::string& name) const {
+    const auto it = object_names_.find(name);
+    return it == object_names_.end() ? nullptr : &it->second;
+  }
+
   const std::vector<Action>& actions() const { return actions_; }
 
   const std::vector<Predicate>& predicates() const { return predicates_; }
@@ -245,11 +544,50 @@ class Pddl {
     return derived_predicates_;
   }
 
+  /**
+   * Derived predicates compiled into stratified rules.
+   */
+  const DatalogProgram& derived_program() const { return derived_program_; }
+
+  /**
+   * Predicates that are not modified by any action or axiom effect and are not
+   * derived. Equality and predicates named after types are evaluated from the
+   * objects instead, so they are not included. Static predicates are only
+   * computed when a problem is loaded.
+   *
+   * @seepython{symbolic.Pddl,static_predicates}
+   */
+  const std::set<std::string>& static_predicates() const {
+    return static_predicates_;
+  }
+
+  bool IsStatic(const std::string& name_predicate) const {
+    return static_predicates_.find(name_predicate) != static_predicates_.end();
+  }
+
+  /**
+   * Static propositions of the initial state, which hold in every state
+   * reachable from it.
+   *
+   * Ground() skips the arguments that violate the static precondition
+   * literals and evaluates the static literals of the ground actions, so the
+   * ground actions assume the static propositions at the time of grounding.
+   * The lifted parameter domains are left unchanged.
+   *
+   * @seepython{symbolic.Pddl,static_state}
+   */
+  const State& static_state() const { return static_state_; }
+
   const StateIndex& state_index() const { return state_index_; }
 
   const Formula& goal() const { return goal_; }
 
  private:
+  /**
+   * Clears the ground actions after a change that invalidates them.
+   */
+  void ClearGroundActions();
+
   std::shared_ptr<VAL::analysis> analysis_;
   std::string domain_pddl_;
   std::string problem_pddl_;
@@ -257,18 +595,29 @@ class Pddl {
   std::vector<Object> constants_;
   std::vector<Object> objects_;
   ObjectTypeMap object_map_;
+  ObjectNameMap object_names_;
 
   AxiomContextMap axiom_map_;
   std::vector<Action> actions_;
+  std::unordered_map<std::string, size_t> idx_actions_;
   std::vector<std::shared_ptr<Axiom>> axioms_;
 
   std::vector<Predicate> predicates_;
   std::vector<DerivedPredicate> derived_predicates_;
+  DatalogProgram derived_program_;
+
+  std::set<std::string> static_predicates_;
+  State static_state_;
 
   StateIndex state_index_;
 
   State initial_state_;
   Formula goal_;
+
+  bool is_grounded_ = false;
+  std::vector<GroundAction> ground_actions_;
+  SuccessorGenerator successor_generator_;
+  RelevanceIndex relevance_index_;
 };
 
 std::set<std::string> Stringify(const State& state);
@@ -12,7 +12,9 @@
 
 #include <cstddef>   // ptrdiff_t
 #include <iterator>  // std::input_iterator_tag
+#include <limits>    // std::numeric_limits
 #include <queue>     // std::priority_queue
+#include <utility>   // std::move
 #include <vector>    // std::vector
 
 namespace symbolic {
@@ -29,6 +31,90 @@ struct SearchNode {
   std::vector<NodeT> ancestors;
 };
 
+/**
+ * Search node that evaluates the heuristic on `node.state()` once, when it is
+ * created, so that the AStar queue compares stored values.
+ *
+ * Children are wrapped as they are generated. The heuristic must outlive the
+ * nodes.
+ */
+template <typename NodeT, typename Heuristic>
+class HeuristicNode {
+ public:
+  class iterator;
+
+  HeuristicNode(const NodeT& node, const Heuristic& heuristic)
+      : node_(node), heuristic_(&heuristic), h_(heuristic(node.state())) {}
+
+  const NodeT& node() const { return node_; }
+
+  /**
+   * Heuristic value of the node state.
+   */
+  size_t h() const { return h_; }
+
+  iterator begin() const { return iterator(node_.begin(), heuristic_); }
+  iterator end() const { return iterator(node_.end(), heuristic_); }
+
+  explicit operator bool() const { return static_cast<bool>(node_); }
+
+ private:
+  NodeT node_;
+  const Heuristic* heuristic_;
+  size_t h_;
+};
+
+template <typename NodeT, typename Heuristic>
+class HeuristicNode<NodeT, Heuristic>::iterator {
+ public:
+  using iterator_category = std::input_iterator_tag;
+  using value_type = HeuristicNode<NodeT, Heuristic>;
+  using difference_type = ptrdiff_t;
+  using pointer = const value_type*;
+  using reference = value_type;
+
+  iterator(typename NodeT::iterator it, const Heuristic* heuristic)
+      : it_(std::move(it)), heuristic_(heuristic) {}
+
+  iterator& operator++() {
+    ++it_;
+    return *this;
+  }
+  bool operator==(const iterator& other) const { return it_ == other.it_; }
+  bool operator!=(const iterator& other) const { return !(*this == other); }
+  reference operator*() const { return value_type(*it_, *heuristic_); }
+
+ private:
+  typename NodeT::iterator it_;
+  const Heuristic* heuristic_;
+};
+
+/**
+ * AStar comparator that orders search nodes by their depth plus the stored
+ * heuristic value `node.h()`, such as of a HeuristicNode. Nodes with equal
+ * estimates are ordered deepest first.
+ */
+template <typename NodeT>
+struct HeuristicCompare {
+  /**
+   * Returns whether the left node should be expanded after the right one.
+   */
+  bool operator()(const SearchNode<NodeT>& left,
+                  const SearchNode<NodeT>& right) const {
+    const size_t f_left = Cost(left);
+    const size_t f_right = Cost(right);
+    if (f_left != f_right) return f_left > f_right;
+    return left.ancestors.size() < right.ancestors.size();
+  }
+
+  static size_t Cost(const SearchNode<NodeT>& node) {
+    const size_t h = node.node.h();
+    // Saturate to keep dead ends behind every other node.
+    if (h == std::numeric_limits<size_t>::max()) return h;
+    return node.ancestors.size() + h;
+  }
+};
+
 template <typename NodeT, typename Compare>
 class AStar {
  public:
@@ -61,7 +147,7 @@ class AStar<NodeT, Compare>::iterator {
 
   explicit iterator(const Compare& compare) : queue_(compare) {}
   iterator(const Compare& compare, const NodeT& root, size_t max_depth)
-      : queue_(compare), kMaxDepth(max_depth) {
+      : kMaxDepth(max_depth), queue_(compare) {
     queue_.emplace(root, std::vector<NodeT>());
   }
 
@@ -0,0 +1,93 @@
+/**
+ * best_first_search.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_PLANNING_BEST_FIRST_SEARCH_H_
+#define SYMBOLIC_PLANNING_BEST_FIRST_SEARCH_H_
+
+#include <functional>  // std::function
+#include <optional>    // std::optional
+#include <string>      // std::string
+#include <vector>      // std::vector
+
+#include "symbolic/pddl.h"
+
+namespace symbolic {
+
+/**
+ * Best-first search over the ground actions that expands the open node with
+ * the lowest f = g + weight * h, breaking ties by lower h.
+ *
+ * With weight 1 this is A*, which returns optimal plans with an admissible
+ * heuristic such as RelaxationHeuristic::Type::kMax. Larger weights trade plan
+ * quality for speed and approach greedy best-first search.
+ *
+ * Successors are generated by the successor generator of the pddl, so the
+ * actions must have been grounded with Pddl::Ground(). Without axioms and
+ * derived predicates the successors are computed with the ground actions
+ * directly, and otherwise with the lifted actions as in Pddl::NextState().
+ *
+ * Duplicates are detected with a closed list over all the generated states.
+ * Each state keeps its cheapest path, and states reached more cheaply later
+ * are reopened.
+ */
+class BestFirstSearch {
+ public:
+  /**
+   * Heuristic estimate of the cost to the goal, or a value of
+   * RelaxationHeuristic::kInfinity for dead ends, which are pruned.
+   */
+  using Heuristic = std::function<size_t(const StateIndex::IndexedState&)>;
+
+  struct Statistics {
+    size_t num_expanded = 0;
+    size_t num_generated = 0;
+    size_t num_reopened = 0;
+  };
+
+  /**
+   * @param pddl Pddl instance with grounded actions.
+   * @param heuristic Heuristic function.
+   * @param weight Weight of the heuristic in the node priority.
+   */
+  BestFirstSearch(const Pddl& pddl, Heuristic heuristic, double weight = 1.);
+
+  /**
+   * Searches for a plan from the given state.
+   *
+   * @param state Initial state.
+   * @param max_expansions Maximum number of node expansions, or 0 for no
+   *                       limit.
+   * @returns Plan as action calls in the form of `"action(obj_a, obj_b)"`, or
+   *          nullopt if no plan was found.
+   *
+   * @seepython{symbolic.BestFirstSearch,search}
+   */
+  std::optional<std::vector<std::string>> Search(const State& state,
+                                                 size_t max_expansions = 0);
+
+  const Pddl& pddl() const { return pddl_; }
+
+  /**
+   * Statistics of the last search.
+   */
+  const Statistics& statistics() const { return statistics_; }
+
+ private:
+  const Pddl& pddl_;
+  const Heuristic heuristic_;
+  const double weight_;
+
+  const std::vector<GroundConjunction> goal_;
+
+  Statistics statistics_;
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_PLANNING_BEST_FIRST_SEARCH_H_
@@ -10,14 +10,12 @@
 #ifndef SYMBOLIC_PLANNING_BREADTH_FIRST_SEARCH_H_
 #define SYMBOLIC_PLANNING_BREADTH_FIRST_SEARCH_H_
 
-#include <chrono>    // std::chrono
-#include <cstddef>   // ptrdiff_t
-#include <iostream>  // std::cout
-#include <iterator>  // std::input_iterator_tag
-#include <memory>    // std::shared_ptr
-#include <queue>     // std::queue
-#include <utility>   // std::pair
-#include <vector>    // std::vector
+#include <algorithm>  // std::reverse
+#include <chrono>     // std::chrono
+#include <cstddef>    // ptrdiff_t
+#include <iostream>   // std::cout
+#include <iterator>   // std::input_iterator_tag
+#include <vector>     // std::vector
 
 namespace symbolic {
 
@@ -59,8 +57,7 @@ class BreadthFirstSearch<NodeT>::iterator {
 
   iterator() = default;
   explicit iterator(const BreadthFirstSearch<NodeT>* bfs)
-      : bfs_(bfs),
-        queue_({{bfs_->root_, std::make_shared<std::vector<NodeT>>()}}) {}
+      : bfs_(bfs), nodes_({{bfs_->root_, 0, 0}}) {}
 
   iterator& operator++();
 
@@ -70,42 +67,75 @@ class BreadthFirstSearch<NodeT>::iterator {
 
   bool operator!=(const iterator& other) const { return !(*this == other); }
 
-  reference operator*() const { return *ancestors_; }
+  reference operator*() const { return plan_; }
 
  private:
+  /**
+   * Search tree node that points to its parent in the node table.
+   */
+  struct Entry {
+    NodeT node;
+    size_t idx_parent;
+    size_t depth;
+  };
+
+  bool IsFinished() const {
+    return idx_front_ == nodes_.size() && plan_.empty();
+  }
+
+  /**
+   * Follows the parent indices back to the root.
+   */
+  std::vector<NodeT> GetPath(size_t idx_node) const;
+
   const BreadthFirstSearch<NodeT>* bfs_ = nullptr;
-  bool IsFinished() const { return queue_.empty() && !ancestors_; }
 
-  std::queue<std::pair<NodeT, std::shared_ptr<std::vector<NodeT>>>> queue_;
-  std::shared_ptr<std::vector<NodeT>> ancestors_;
+  // Node table in the order that nodes are generated. Since BFS expands nodes
+  // in the same order, the queue is the range of ids starting at idx_front_.
+  std::vector<Entry> nodes_;
+  size_t idx_front_ = 0;
+
+  std::vector<NodeT> plan_;
 };
 
+template <typename NodeT>
+std::vector<NodeT> BreadthFirstSearch<NodeT>::iterator::GetPath(
+    size_t idx_node) const {
+  std::vector<NodeT> path;
+  path.reserve(nodes_[idx_node].depth + 1);
+  while (true) {
+    const Entry& entry = nodes_[idx_node];
+    path.push_back(entry.node);
+    if (entry.depth == 0) break;
+    idx_node = entry.idx_parent;
+  }
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
 template <typename NodeT>
 typename BreadthFirstSearch<NodeT>::iterator&
 BreadthFirstSearch<NodeT>::iterator::operator++() {
   const auto t_start = std::chrono::high_resolution_clock::now();
   size_t depth = 0;
-  while (!queue_.empty()) {
+  while (idx_front_ < nodes_.size()) {
     // Abort on timeout.
     if (bfs_->timeout_.count() > 0 &&
         std::chrono::high_resolution_clock::now() - t_start > bfs_->timeout_) {
-      std::queue<std::pair<NodeT, std::shared_ptr<std::vector<NodeT>>>> empty;
-      std::swap(queue_, empty);
+      nodes_.clear();
+      idx_front_ = 0;
       break;
     }
 
-    std::pair<NodeT, std::shared_ptr<std::vector<NodeT>>>& front =
-        queue_.front();
-
-    // Take ancestors list and append current node
-    ancestors_ = std::make_shared<std::vector<NodeT>>(*front.second);
-    ancestors_->push_back(std::move(front.first));
-    queue_.pop();
-    const NodeT& node = ancestors_->back();
+    // Pop the front of the queue. The node is copied because adding children
+    // may reallocate the node table.
+    const size_t idx_node = idx_front_++;
+    const NodeT node = nodes_[idx_node].node;
+    const size_t depth_node = nodes_[idx_node].depth;
 
     // Print search depth
-    if (bfs_->verbose_ && ancestors_->size() > depth) {
-      depth = ancestors_->size();
+    if (bfs_->verbose_ && depth_node + 1 > depth) {
+      depth = depth_node + 1;
       std::cout << "BFS depth: " << depth - 1 << std::endl;
     }
 
@@ -114,16 +144,17 @@ BreadthFirstSearch<NodeT>::iterator::operator++() {
       if (bfs_->verbose_) {
         std::cout << "Goal state reached: " << node << std::endl;
       }
+      plan_ = GetPath(idx_node);
       return *this;
     }
 
     // Skip children if max depth has been reached
-    if (ancestors_->size() > bfs_->max_depth_) continue;
+    if (depth_node >= bfs_->max_depth_) continue;
 
     // Add node's children to queue
     if (bfs_->verbose_) {
-      for (const NodeT& node : *ancestors_) {
-        std::cout << node << std::endl;
+      for (const NodeT& ancestor : GetPath(idx_node)) {
+        std::cout << ancestor << std::endl;
       }
       std::cout << "====================" << std::endl;
     }
@@ -133,10 +164,10 @@ BreadthFirstSearch<NodeT>::iterator::operator++() {
         std::cout << child << std::endl << std::endl;
       }
 
-      queue_.emplace(child, ancestors_);
+      nodes_.push_back({child, idx_node, depth_node + 1});
     }
   }
-  ancestors_.reset();
+  plan_.clear();
   return *this;
 }
 
@@ -0,0 +1,93 @@
+/**
+ * hash_distributed_a_star.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_PLANNING_HASH_DISTRIBUTED_A_STAR_H_
+#define SYMBOLIC_PLANNING_HASH_DISTRIBUTED_A_STAR_H_
+
+#include <optional>  // std::optional
+#include <string>    // std::string
+#include <vector>    // std::vector
+
+#include "symbolic/pddl.h"
+#include "symbolic/planning/best_first_search.h"
+#include "symbolic/utils/thread_pool.h"
+
+namespace symbolic {
+
+/**
+ * Hash-distributed A* (HDA*) over the ground actions.
+ *
+ * Every thread of the pool runs a worker that owns the open and closed lists
+ * of the states whose hash maps to it. Generated successors are sent to their
+ * owners through lock-free multiple-producer single-consumer queues. States
+ * are hashed with Zobrist keys, which are updated incrementally from the
+ * propositions changed by each action.
+ *
+ * The first goal found sets an incumbent plan, and workers keep expanding
+ * nodes with f below its cost. The search terminates once every worker is out
+ * of such nodes and all of the sent successors have been received, so the
+ * plan is optimal with an admissible heuristic.
+ *
+ * The heuristic is called concurrently from all of the workers, and the pool
+ * must not be running other tasks. Successors are generated as in
+ * BestFirstSearch, so the actions must have been grounded with Pddl::Ground().
+ */
+class HashDistributedAStar {
+ public:
+  struct Statistics {
+    size_t num_expanded = 0;
+    size_t num_generated = 0;
+    size_t num_sent = 0;
+  };
+
+  /**
+   * @param pddl Pddl instance with grounded actions.
+   * @param heuristic Thread-safe heuristic function.
+   * @param pool Thread pool whose threads run the workers.
+   */
+  HashDistributedAStar(const Pddl& pddl, BestFirstSearch::Heuristic heuristic,
+                       ThreadPool* pool);
+
+  /**
+   * Searches for an optimal plan from the given state.
+   *
+   * @param state Initial state.
+   * @param max_expansions Maximum number of node expansions over all of the
+   *                       workers, or 0 for no limit.
+   * @returns Plan as action calls in the form of `"action(obj_a, obj_b)"`, or
+   *          nullopt if no plan was found within the expansion limit.
+   *
+   * @seepython{symbolic.HashDistributedAStar,search}
+   */
+  std::optional<std::vector<std::string>> Search(const State& state,
+                                                 size_t max_expansions = 0);
+
+  const Pddl& pddl() const { return pddl_; }
+
+  /**
+   * Statistics of the last search.
+   */
+  const Statistics& statistics() const { return statistics_; }
+
+ private:
+  const Pddl& pddl_;
+  const BestFirstSearch::Heuristic heuristic_;
+  ThreadPool* pool_;
+
+  const std::vector<GroundConjunction> goal_;
+
+  // Zobrist key of each StateIndex proposition.
+  std::vector<size_t> keys_;
+
+  Statistics statistics_;
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_PLANNING_HASH_DISTRIBUTED_A_STAR_H_
@@ -0,0 +1,79 @@
+/**
+ * in_place_depth_first_search.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_PLANNING_IN_PLACE_DEPTH_FIRST_SEARCH_H_
+#define SYMBOLIC_PLANNING_IN_PLACE_DEPTH_FIRST_SEARCH_H_
+
+#include <optional>  // std::optional
+#include <string>    // std::string
+#include <vector>    // std::vector
+
+#include "symbolic/pddl.h"
+#include "symbolic/undo_log.h"
+
+namespace symbolic {
+
+/**
+ * Depth-first search that keeps a single mutable state.
+ *
+ * Children are generated by applying actions in place and backtracking with
+ * the undo log, so no state is copied per node. Paths that return to a state
+ * on the current path are pruned by comparing the recorded changes.
+ */
+class InPlaceDepthFirstSearch {
+ public:
+  /**
+   * @param pddl Pddl instance.
+   * @param state State from which to search.
+   * @param max_depth Maximum plan length.
+   *
+   * @seepython{symbolic.InPlaceDepthFirstSearch,__init__}
+   */
+  InPlaceDepthFirstSearch(const Pddl& pddl, const State& state,
+                          size_t max_depth);
+
+  /**
+   * Searches for a plan up to the maximum depth.
+   *
+   * @returns Action calls of the first plan found, or nullopt if none exists.
+   *
+   * @seepython{symbolic.InPlaceDepthFirstSearch,search}
+   */
+  std::optional<std::vector<std::string>> Search();
+
+  /**
+   * Searches with increasing depth limits up to the maximum depth, which
+   * returns a shortest plan.
+   *
+   * @returns Action calls of the first plan found, or nullopt if none exists.
+   *
+   * @seepython{symbolic.InPlaceDepthFirstSearch,search_iterative_deepening}
+   */
+  std::optional<std::vector<std::string>> SearchIterativeDeepening();
+
+  /**
+   * Number of nodes generated by the last search.
+   */
+  size_t num_generated() const { return num_generated_; }
+
+ private:
+  std::optional<std::vector<std::string>> Search(size_t max_depth);
+
+  const Pddl& pddl_;
+  const State root_;
+  const size_t max_depth_;
+
+  State state_;
+  UndoLog log_;
+  size_t num_generated_ = 0;
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_PLANNING_IN_PLACE_DEPTH_FIRST_SEARCH_H_
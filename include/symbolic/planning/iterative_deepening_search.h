@@ -0,0 +1,126 @@
+/**
+ * iterative_deepening_search.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_PLANNING_ITERATIVE_DEEPENING_SEARCH_H_
+#define SYMBOLIC_PLANNING_ITERATIVE_DEEPENING_SEARCH_H_
+
+#include <chrono>    // std::chrono
+#include <cstdint>   // uint64_t
+#include <limits>    // std::numeric_limits
+#include <optional>  // std::optional
+#include <string>    // std::string
+#include <vector>    // std::vector
+
+#include "symbolic/pddl.h"
+
+namespace symbolic {
+
+/**
+ * Iterative deepening depth-first search over the ground actions with a
+ * fixed-size transposition table.
+ *
+ * Each entry of the table records a state hash along with the largest
+ * remaining depth with which the state has been expanded, and nodes that
+ * reach a state with no more remaining depth are pruned. Within one iteration,
+ * this is the same as pruning states already seen at the same depth or
+ * shallower. Since a completed iteration has explored every recorded state up
+ * to its remaining depth, the entries also stay valid in later iterations.
+ *
+ * The table is split into buckets of two entries. The first entry keeps the
+ * state with the most remaining depth, whose subtree is the most expensive to
+ * search again, and the second entry always takes the newest state. Evicted
+ * states are only searched again, so the memory used by the search is bounded
+ * by the table and the current path, regardless of the size of the state
+ * space. States are identified by their hashes alone, so a hash collision may
+ * prune a state that hasn't been seen.
+ *
+ * Successors are generated as in BestFirstSearch, so the actions must have
+ * been grounded with Pddl::Ground().
+ */
+class IterativeDeepeningSearch {
+ public:
+  static constexpr size_t kDefaultTableSize = 1 << 20;
+
+  struct Statistics {
+    size_t num_expanded = 0;
+    size_t num_generated = 0;
+    size_t num_pruned = 0;
+    size_t depth = 0;
+    bool is_aborted = false;
+  };
+
+  /**
+   * @param pddl Pddl instance with grounded actions.
+   * @param table_size Number of entries in the transposition table, which is
+   *                   rounded down to a power of two. Each entry takes 16
+   *                   bytes.
+   *
+   * @seepython{symbolic.IterativeDeepeningSearch,__init__}
+   */
+  explicit IterativeDeepeningSearch(const Pddl& pddl,
+                                    size_t table_size = kDefaultTableSize);
+
+  /**
+   * Searches with increasing depth limits up to the maximum depth, which
+   * returns a shortest plan.
+   *
+   * The search is aborted once either budget is exceeded, in which case
+   * `statistics().is_aborted` is set.
+   *
+   * @param state Initial state.
+   * @param max_depth Maximum plan length.
+   * @param max_expansions Maximum number of node expansions over all of the
+   *                       iterations, or 0 for no limit.
+   * @param us_timeout Maximum search time, or 0 for no limit.
+   * @returns Plan as action calls in the form of `"action(obj_a, obj_b)"`, or
+   *          nullopt if no plan was found within the budgets.
+   *
+   * @seepython{symbolic.IterativeDeepeningSearch,search}
+   */
+  std::optional<std::vector<std::string>> Search(
+      const State& state, size_t max_depth, size_t max_expansions = 0,
+      std::chrono::microseconds us_timeout = std::chrono::microseconds(0));
+
+  const Pddl& pddl() const { return pddl_; }
+
+  size_t table_size() const { return table_.size(); }
+
+  /**
+   * Statistics of the last search, summed over the iterations.
+   */
+  const Statistics& statistics() const { return statistics_; }
+
+ private:
+  struct Entry {
+    static constexpr uint64_t kEmpty = std::numeric_limits<uint64_t>::max();
+
+    uint64_t hash = 0;
+    uint64_t remaining = kEmpty;
+  };
+
+  /**
+   * Records that the state will be expanded with the given remaining depth.
+   *
+   * @returns False if the state has already been expanded with at least as
+   *          much remaining depth, in which case it should be pruned.
+   */
+  bool Visit(uint64_t hash, uint64_t remaining);
+
+  const Pddl& pddl_;
+
+  const std::vector<GroundConjunction> goal_;
+
+  std::vector<Entry> table_;
+
+  Statistics statistics_;
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_PLANNING_ITERATIVE_DEEPENING_SEARCH_H_
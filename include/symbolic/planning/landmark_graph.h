@@ -0,0 +1,119 @@
+/**
+ * landmark_graph.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_PLANNING_LANDMARK_GRAPH_H_
+#define SYMBOLIC_PLANNING_LANDMARK_GRAPH_H_
+
+#include <utility>  // std::pair
+#include <vector>   // std::vector
+
+#include "symbolic/pddl.h"
+#include "symbolic/planning/relaxed_task.h"
+
+namespace symbolic {
+
+/**
+ * Fact landmarks of the goal, which are propositions that must be true at some
+ * point in every plan from a given state.
+ *
+ * Landmarks are found by propagating labels over the relaxed planning graph
+ * (Zhu and Givan). The label of a proposition is the set of propositions that
+ * every relaxed plan reaching it must reach first. The label of a unit is the
+ * union of the labels of its preconditions, and the label of a proposition is
+ * the intersection over its achievers, which is iterated to a fixed point.
+ * Since every plan is a relaxed plan, the labels of the goal propositions are
+ * landmarks of the real task.
+ *
+ * With a disjunctive goal, the landmarks are the ones shared by all of the
+ * relaxed reachable disjuncts.
+ */
+class LandmarkGraph {
+ public:
+  /**
+   * Natural ordering where landmark `first` must be true before landmark
+   * `second` becomes true for the first time. Landmarks are given by their
+   * StateIndex indices.
+   */
+  using Ordering = std::pair<size_t, size_t>;
+
+  /**
+   * Extracts the landmarks from the given state.
+   *
+   * @param task Relaxed task.
+   * @param state Indexed state from which to plan.
+   */
+  LandmarkGraph(const RelaxedTask& task, const StateIndex::IndexedState& state);
+
+  /**
+   * Extracts the landmarks from the given state. The actions must have been
+   * grounded with Pddl::Ground().
+   *
+   * @seepython{symbolic.LandmarkGraph,__init__}
+   */
+  LandmarkGraph(const Pddl& pddl, const State& state);
+
+  /**
+   * Whether the goal is reachable under the relaxation. If not, the goal is
+   * unreachable from the state and there are no landmarks.
+   */
+  bool is_reachable() const { return is_reachable_; }
+
+  /**
+   * Landmarks as StateIndex indices in increasing order.
+   */
+  const std::vector<size_t>& landmarks() const { return landmarks_; }
+
+  /**
+   * Natural orderings between the landmarks, sorted by (first, second).
+   * Orderings implied by transitivity are not removed.
+   */
+  const std::vector<Ordering>& orderings() const { return orderings_; }
+
+ private:
+  bool is_reachable_ = false;
+  std::vector<size_t> landmarks_;
+  std::vector<Ordering> orderings_;
+};
+
+/**
+ * Landmark-count heuristic, which counts the landmarks of the goal that are
+ * false in the evaluated state.
+ *
+ * Landmarks are extracted from every evaluated state, so the heuristic only
+ * depends on the state and can be used with BestFirstSearch. States from which
+ * the goal is relaxed unreachable are dead ends. The heuristic is not
+ * admissible, since one action may achieve several landmarks.
+ */
+class LandmarkCountHeuristic {
+ public:
+  /**
+   * Builds the relaxed task. The actions must have been grounded with
+   * Pddl::Ground().
+   */
+  explicit LandmarkCountHeuristic(const Pddl& pddl) : task_(pddl) {}
+
+  /**
+   * Evaluates the heuristic in the given state.
+   *
+   * @returns Number of false landmarks in the cheapest disjunct of the goal,
+   *          or RelaxationHeuristic::kInfinity if the goal is relaxed
+   *          unreachable.
+   */
+  size_t operator()(const StateIndex::IndexedState& state) const;
+  size_t operator()(const State& state) const;
+
+  const Pddl& pddl() const { return task_.pddl(); }
+
+ private:
+  RelaxedTask task_;
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_PLANNING_LANDMARK_GRAPH_H_
@@ -0,0 +1,90 @@
+/**
+ * parallel_breadth_first_search.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_PLANNING_PARALLEL_BREADTH_FIRST_SEARCH_H_
+#define SYMBOLIC_PLANNING_PARALLEL_BREADTH_FIRST_SEARCH_H_
+
+#include <optional>  // std::optional
+#include <string>    // std::string
+#include <vector>    // std::vector
+
+#include "symbolic/pddl.h"
+#include "symbolic/utils/thread_pool.h"
+
+namespace symbolic {
+
+/**
+ * Layer-synchronous breadth-first search over the ground actions that expands
+ * each depth layer across a thread pool.
+ *
+ * Each layer is expanded in three parallel phases:
+ *
+ * 1. The frontier is split into chunks, and each chunk generates its
+ *    successors into its own buffers, dropping states visited in earlier
+ *    layers.
+ * 2. The visited set is sharded by state hash. Each shard inserts the
+ *    successors routed to it in frontier order, so the first parent of a
+ *    state in the layer always claims it.
+ * 3. The claimed successors are concatenated in chunk order to form the next
+ *    frontier.
+ *
+ * No locks are taken, since every shard and buffer is only written by one
+ * task in each phase. The result is the same as a sequential breadth-first
+ * search that expands the actions in increasing id order, regardless of the
+ * number of threads.
+ *
+ * Successors are generated as in BestFirstSearch, so the actions must have
+ * been grounded with Pddl::Ground().
+ */
+class ParallelBreadthFirstSearch {
+ public:
+  struct Statistics {
+    size_t num_expanded = 0;
+    size_t num_generated = 0;
+    size_t depth = 0;
+  };
+
+  /**
+   * @param pddl Pddl instance with grounded actions.
+   * @param pool Thread pool that expands the layers.
+   */
+  ParallelBreadthFirstSearch(const Pddl& pddl, ThreadPool* pool);
+
+  /**
+   * Searches for a shortest plan from the given state.
+   *
+   * @param state Initial state.
+   * @param max_depth Maximum plan length, or 0 for no limit.
+   * @returns Plan as action calls in the form of `"action(obj_a, obj_b)"`, or
+   *          nullopt if no plan was found.
+   *
+   * @seepython{symbolic.ParallelBreadthFirstSearch,search}
+   */
+  std::optional<std::vector<std::string>> Search(const State& state,
+                                                 size_t max_depth = 0);
+
+  const Pddl& pddl() const { return pddl_; }
+
+  /**
+   * Statistics of the last search.
+   */
+  const Statistics& statistics() const { return statistics_; }
+
+ private:
+  const Pddl& pddl_;
+  ThreadPool* pool_;
+
+  const std::vector<GroundConjunction> goal_;
+
+  Statistics statistics_;
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_PLANNING_PARALLEL_BREADTH_FIRST_SEARCH_H_
@@ -0,0 +1,101 @@
+/**
+ * parallel_depth_first_search.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_PLANNING_PARALLEL_DEPTH_FIRST_SEARCH_H_
+#define SYMBOLIC_PLANNING_PARALLEL_DEPTH_FIRST_SEARCH_H_
+
+#include <optional>  // std::optional
+#include <string>    // std::string
+#include <vector>    // std::vector
+
+#include "symbolic/pddl.h"
+#include "symbolic/utils/thread_pool.h"
+
+namespace symbolic {
+
+/**
+ * Depth-limited search over the ground actions that splits subtrees across a
+ * thread pool with work stealing.
+ *
+ * Every thread of the pool owns a deque of open nodes. It expands the newest
+ * node of its own deque, so each thread runs a depth-first search, and when
+ * its deque is empty, it steals the oldest node of another thread, which
+ * roots the largest unexplored subtree. Nodes share the actions to their
+ * ancestors through parent links instead of copying them.
+ *
+ * A transposition table shared by all of the threads records the lowest depth
+ * at which each state has been reached, and nodes that reach a state no
+ * shallower are pruned. The first thread to find a plan cancels the others.
+ *
+ * Successors are generated as in BestFirstSearch, so the actions must have
+ * been grounded with Pddl::Ground(). The pool must not be running other tasks.
+ */
+class ParallelDepthFirstSearch {
+ public:
+  struct Statistics {
+    size_t num_expanded = 0;
+    size_t num_generated = 0;
+    size_t num_stolen = 0;
+  };
+
+  /**
+   * @param pddl Pddl instance with grounded actions.
+   * @param pool Thread pool whose threads run the searches.
+   */
+  ParallelDepthFirstSearch(const Pddl& pddl, ThreadPool* pool);
+
+  /**
+   * Searches for any plan up to the maximum depth.
+   *
+   * @param state Initial state.
+   * @param max_depth Maximum plan length.
+   * @returns Action calls of the first plan found by any thread, or nullopt if
+   *          none exists.
+   *
+   * @seepython{symbolic.ParallelDepthFirstSearch,search}
+   */
+  std::optional<std::vector<std::string>> Search(const State& state,
+                                                 size_t max_depth);
+
+  /**
+   * Searches with increasing depth limits up to the maximum depth, which
+   * returns a shortest plan.
+   *
+   * @param state Initial state.
+   * @param max_depth Maximum plan length.
+   * @returns Action calls of the first plan found, or nullopt if none exists.
+   *
+   * @seepython{symbolic.ParallelDepthFirstSearch,search_iterative_deepening}
+   */
+  std::optional<std::vector<std::string>> SearchIterativeDeepening(
+      const State& state, size_t max_depth);
+
+  const Pddl& pddl() const { return pddl_; }
+
+  /**
+   * Statistics of the last search, summed over the iterations of iterative
+   * deepening.
+   */
+  const Statistics& statistics() const { return statistics_; }
+
+ private:
+  std::optional<std::vector<std::string>> SearchDepthLimited(
+      const StateIndex::IndexedState& root, size_t max_depth);
+
+  const Pddl& pddl_;
+  ThreadPool* pool_;
+
+  const std::vector<GroundConjunction> goal_;
+
+  Statistics statistics_;
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_PLANNING_PARALLEL_DEPTH_FIRST_SEARCH_H_
@@ -0,0 +1,173 @@
+/**
+ * pattern_database.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_PLANNING_PATTERN_DATABASE_H_
+#define SYMBOLIC_PLANNING_PATTERN_DATABASE_H_
+
+#include <cstdint>  // uint64_t, uint8_t
+#include <string>   // std::string
+#include <utility>  // std::move
+#include <vector>   // std::vector
+
+#include "symbolic/pddl.h"
+
+namespace symbolic {
+
+/**
+ * Pattern database over a subset of the propositions in the StateIndex.
+ *
+ * States are projected onto the propositions of the pattern, and the ground
+ * actions are projected onto the abstract states by dropping the
+ * preconditions and effects outside of the pattern. The distances from every
+ * abstract state to the goal are computed once with a backward breadth-first
+ * search and stored in a table with one byte per abstract state. The distance
+ * of the projected state is an admissible estimate of the plan length.
+ *
+ * Conditional effects whose conditions can't be decided in the abstraction
+ * may or may not fire. Propositions of derived predicates and axiom effects
+ * aren't controlled by the ground actions and are dropped from the pattern.
+ */
+class PatternDatabase {
+ public:
+  /**
+   * Distance stored for abstract states from which the goal is unreachable.
+   */
+  static constexpr uint8_t kUnreachable = 255;
+
+  /**
+   * Maximum number of propositions in a pattern.
+   */
+  static constexpr size_t kMaxPatternSize = 24;
+
+  /**
+   * Builds the pattern database. The actions must have been grounded with
+   * Pddl::Ground().
+   *
+   * @param pddl Pddl object.
+   * @param pattern StateIndex indices of the pattern propositions.
+   *
+   * @seepython{symbolic.PatternDatabase,__init__}
+   */
+  PatternDatabase(const Pddl& pddl, const std::vector<size_t>& pattern);
+
+  /**
+   * Creates a pattern from predicate names, which select all of their
+   * propositions, and ground propositions.
+   *
+   * @param pddl Pddl object.
+   * @param atoms Predicate names or propositions, such as `"inhand"` or
+   *              `"on(box, shelf)"`.
+   * @returns Sorted StateIndex indices of the pattern propositions.
+   *
+   * @seepython{symbolic.PatternDatabase,create_pattern}
+   */
+  static std::vector<size_t> CreatePattern(
+      const Pddl& pddl, const std::vector<std::string>& atoms);
+
+  /**
+   * Loads a pattern database saved with Save(). The actions must have been
+   * grounded with Pddl::Ground().
+   *
+   * The file stores a fingerprint of the domain name, the pattern, and the
+   * projected goal and ground actions, and is rejected if it doesn't match
+   * the given Pddl, since the distances would be invalid for it.
+   *
+   * @seepython{symbolic.PatternDatabase,load}
+   */
+  static PatternDatabase Load(const Pddl& pddl, const std::string& filename);
+
+  /**
+   * Saves the pattern and distance table.
+   *
+   * @seepython{symbolic.PatternDatabase,save}
+   */
+  void Save(const std::string& filename) const;
+
+  /**
+   * Looks up the abstract distance of the state.
+   *
+   * @returns Distance to the goal, or RelaxationHeuristic::kInfinity if the
+   *          goal is unreachable.
+   */
+  size_t operator()(const StateIndex::IndexedState& state) const;
+  size_t operator()(const State& state) const;
+
+  const Pddl& pddl() const { return *pddl_; }
+
+  /**
+   * StateIndex indices of the pattern propositions in increasing order.
+   */
+  const std::vector<size_t>& pattern() const { return pattern_; }
+
+  /**
+   * Distances indexed by abstract state, where bit i of the index is the
+   * value of proposition pattern()[i]. Distances above 254 are saturated.
+   */
+  const std::vector<uint8_t>& distances() const { return distances_; }
+
+ private:
+  PatternDatabase(const Pddl& pddl, std::vector<size_t>&& pattern,
+                  std::vector<uint8_t>&& distances, uint64_t fingerprint)
+      : pddl_(&pddl),
+        pattern_(std::move(pattern)),
+        distances_(std::move(distances)),
+        fingerprint_(fingerprint) {}
+
+  const Pddl* pddl_;
+  std::vector<size_t> pattern_;
+  std::vector<uint8_t> distances_;
+
+  // Hash of the abstraction, which is saved with the distances.
+  uint64_t fingerprint_ = 0;
+};
+
+/**
+ * Admissible combination of pattern databases.
+ */
+class PatternDatabaseHeuristic {
+ public:
+  enum class Combination {
+    // Sum of the distances. Admissible only if no ground action has effects
+    // in more than one pattern, which is checked in the constructor.
+    kSum,
+
+    // Maximum of the distances.
+    kMax,
+  };
+
+  /**
+   * @param pdbs Non-empty pattern databases of the same Pddl.
+   * @param combination How to combine the distances.
+   */
+  PatternDatabaseHeuristic(std::vector<PatternDatabase> pdbs,
+                           Combination combination);
+
+  /**
+   * Evaluates the heuristic in the given state.
+   *
+   * @returns Combined distance, or RelaxationHeuristic::kInfinity if the goal
+   *          is unreachable in one of the abstractions.
+   */
+  size_t operator()(const StateIndex::IndexedState& state) const;
+  size_t operator()(const State& state) const;
+
+  const Pddl& pddl() const { return pdbs_.front().pddl(); }
+
+  const std::vector<PatternDatabase>& pdbs() const { return pdbs_; }
+
+  Combination combination() const { return combination_; }
+
+ private:
+  std::vector<PatternDatabase> pdbs_;
+  Combination combination_;
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_PLANNING_PATTERN_DATABASE_H_
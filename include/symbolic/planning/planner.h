@@ -13,6 +13,7 @@
 #include <functional>  // std::hash
 #include <iostream>    // std::ostream
 #include <memory>      // std::shared_ptr
+#include <vector>      // std::vector
 
 #include "symbolic/pddl.h"
 
@@ -20,6 +21,23 @@ namespace symbolic {
 
 class Planner {
  public:
+  /**
+   * How children that revisit a state are pruned.
+   */
+  enum class DuplicateDetection {
+    // Prune children whose state appears on the path from the root. Every
+    // node keeps its own set of ancestors.
+    kPath,
+
+    // Prune children whose state has been expanded anywhere in the search,
+    // using one closed list shared by all the nodes. A node's state is closed
+    // when its children are first iterated, and other nodes with the same
+    // state then have no children. Meant for breadth-first and best-first
+    // orders, since a depth-limited search may close a state at a depth from
+    // which its descendants can't be reached.
+    kGlobal,
+  };
+
   class Node {
     struct NodeImpl;
 
@@ -28,7 +46,8 @@ class Planner {
     class reverse_iterator;
 
     Node() = default;
-    Node(const Pddl& pddl, const State& state, size_t depth = 0);
+    Node(const Pddl& pddl, const State& state, size_t depth = 0,
+         DuplicateDetection duplicate_detection = DuplicateDetection::kPath);
     Node(const Node& parent, const Node& sibling, State&& state,
          std::string&& action);
 
@@ -36,7 +55,8 @@ class Planner {
     const State& state() const;
     size_t depth() const;
 
-    // Iterate over children
+    // Iterate over children. With DuplicateDetection::kGlobal, children whose
+    // states have since been expanded are skipped on later iterations.
     iterator begin() const;
     iterator end() const;
 
@@ -61,11 +81,19 @@ class Planner {
    * Planner class to find a state that satisfies the goal condition from the
    * initial state.
    *
+   * If the pddl has been grounded with Pddl::Ground(), node children are
+   * generated from the applicable ground actions returned by the successor
+   * generator instead of by testing every action and parameter combination.
+   *
    * @param pddl Pddl instance.
+   * @param duplicate_detection How to prune children that revisit a state.
    *
    * @seepython{symbolic.Planner,__init__}
    */
-  explicit Planner(const Pddl& pddl) : Planner(pddl, pddl.initial_state()) {}
+  explicit Planner(
+      const Pddl& pddl,
+      DuplicateDetection duplicate_detection = DuplicateDetection::kPath)
+      : Planner(pddl, pddl.initial_state(), duplicate_detection) {}
 
   /**
    * Planner class to find a state that satisfies the goal condition from the
@@ -73,11 +101,13 @@ class Planner {
    *
    * @param pddl Pddl instance.
    * @param state State from which to search.
+   * @param duplicate_detection How to prune children that revisit a state.
    *
    * @seepython{symbolic.Planner,__init__}
    */
-  Planner(const Pddl& pddl, const State& state)
-      : root_(pddl, pddl.ConsistentState(state)) {}
+  Planner(const Pddl& pddl, const State& state,
+          DuplicateDetection duplicate_detection = DuplicateDetection::kPath)
+      : root_(pddl, pddl.ConsistentState(state), 0, duplicate_detection) {}
 
   const Node& root() const { return root_; }
 
@@ -102,6 +132,14 @@ class Planner::Node::iterator {
   reference operator*() const { return child_; }
 
  private:
+  // Sets the child to the result of the current ground action and returns
+  // whether the child is a new state.
+  bool ExpandGroundAction();
+
+  // Returns whether the child's state isn't on the path from the root, or
+  // hasn't been expanded with a global closed list.
+  bool IsNewChild() const;
+
   const Pddl& pddl_;
 
   const Node& parent_;
@@ -110,6 +148,13 @@ class Planner::Node::iterator {
   std::vector<Action>::const_iterator it_action_;
   ParameterGenerator::const_iterator it_param_;
 
+  // Applicable ground actions if the pddl is grounded. These are listed by
+  // Node::begin() or when decrementing from the end, so end() iterators
+  // don't run the successor generator.
+  const bool is_grounded_;
+  std::vector<size_t> ground_actions_;
+  size_t idx_ground_action_ = 0;
+
   friend class Node;
 };
 
@@ -0,0 +1,96 @@
+/**
+ * regression_search.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_PLANNING_REGRESSION_SEARCH_H_
+#define SYMBOLIC_PLANNING_REGRESSION_SEARCH_H_
+
+#include <optional>  // std::optional
+#include <string>    // std::string
+#include <vector>    // std::vector
+
+#include "symbolic/pddl.h"
+
+namespace symbolic {
+
+/**
+ * Breadth-first search backward from the goal over partial states.
+ *
+ * The search starts from the conjunctions of the normalized goal. A partial
+ * state is regressed through an action call if the postconditions achieve one
+ * of its propositions without contradicting any of the others, which results
+ * in the remaining propositions conjoined with the preconditions. Regressed
+ * states that are inconsistent with the axioms are pruned, as are states
+ * subsumed by a state already reached, since every state satisfying the new
+ * one also satisfies the old one. A plan is found once a regressed state is
+ * satisfied by the initial state.
+ *
+ * The search only enumerates the propositions relevant to the goal, so it can
+ * be much cheaper than forward search in domains with many actions but narrow
+ * goals. Postconditions with conditional effects normalize to several
+ * conjunctions whose conditions refer to the state before the action, so
+ * actions with conditional effects are not regressed through. Derived
+ * predicates in the goal are only satisfied if they hold in the initial state.
+ */
+class RegressionSearch {
+ public:
+  struct Statistics {
+    size_t num_expanded = 0;
+    size_t num_generated = 0;
+    size_t num_subsumed = 0;
+  };
+
+  /**
+   * Normalizes the pre/post conditions of all the action calls.
+   *
+   * @param pddl Pddl instance.
+   *
+   * @seepython{symbolic.RegressionSearch,__init__}
+   */
+  explicit RegressionSearch(const Pddl& pddl);
+
+  /**
+   * Searches backward from the goal for a shortest plan from the given state.
+   *
+   * @param state Initial state.
+   * @param max_depth Maximum plan length, or 0 for no limit.
+   * @returns Plan as action calls in the form of `"action(obj_a, obj_b)"`, or
+   *          nullopt if no plan was found.
+   *
+   * @seepython{symbolic.RegressionSearch,search}
+   */
+  std::optional<std::vector<std::string>> Search(const State& state,
+                                                 size_t max_depth = 0);
+
+  const Pddl& pddl() const { return pddl_; }
+
+  /**
+   * Statistics of the last search.
+   */
+  const Statistics& statistics() const { return statistics_; }
+
+ private:
+  /**
+   * Action call with one conjunction of its normalized preconditions.
+   */
+  struct Operator {
+    std::string action_call;
+    PartialState pre;
+    PartialState post;
+  };
+
+  const Pddl& pddl_;
+
+  std::vector<Operator> operators_;
+
+  Statistics statistics_;
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_PLANNING_REGRESSION_SEARCH_H_
@@ -0,0 +1,74 @@
+/**
+ * relaxation_heuristic.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_PLANNING_RELAXATION_HEURISTIC_H_
+#define SYMBOLIC_PLANNING_RELAXATION_HEURISTIC_H_
+
+#include <limits>  // std::numeric_limits
+
+#include "symbolic/pddl.h"
+#include "symbolic/planning/relaxed_task.h"
+
+namespace symbolic {
+
+/**
+ * Delete relaxation heuristics over the ground actions.
+ *
+ * See RelaxedTask for the relaxation.
+ */
+class RelaxationHeuristic {
+ public:
+  enum class Type {
+    // Sum of the costs of the goal propositions (h_add). Informative but not
+    // admissible.
+    kAdd,
+
+    // Maximum of the costs of the goal propositions (h_max). Admissible.
+    kMax,
+
+    // Number of actions in the relaxed plan extracted from the h_add best
+    // supporters (h_FF).
+    kFF,
+  };
+
+  /**
+   * Value returned for states from which the goal is unreachable even under
+   * the relaxation.
+   */
+  static constexpr size_t kInfinity = std::numeric_limits<size_t>::max();
+
+  /**
+   * Builds the relaxed planning task. The actions must have been grounded with
+   * Pddl::Ground().
+   *
+   * @param pddl Pddl object.
+   * @param type Heuristic to compute.
+   */
+  RelaxationHeuristic(const Pddl& pddl, Type type);
+
+  /**
+   * Evaluates the heuristic in the given state.
+   *
+   * @returns Heuristic value, or kInfinity if the goal is relaxed unreachable.
+   */
+  size_t operator()(const StateIndex::IndexedState& state) const;
+  size_t operator()(const State& state) const;
+
+  const Pddl& pddl() const { return task_.pddl(); }
+
+  Type type() const { return type_; }
+
+ private:
+  RelaxedTask task_;
+  Type type_;
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_PLANNING_RELAXATION_HEURISTIC_H_
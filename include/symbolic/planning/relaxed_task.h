@@ -0,0 +1,80 @@
+/**
+ * relaxed_task.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_PLANNING_RELAXED_TASK_H_
+#define SYMBOLIC_PLANNING_RELAXED_TASK_H_
+
+#include <vector>  // std::vector
+
+#include "symbolic/pddl.h"
+
+namespace symbolic {
+
+/**
+ * Delete relaxation of the ground actions.
+ *
+ * The relaxation ignores delete effects and negative preconditions, and every
+ * action costs 1. Propositions of derived predicates and axiom effects are not
+ * compiled into the ground actions, so they are assumed to be free, as in
+ * Reachability.
+ */
+class RelaxedTask {
+ public:
+  /**
+   * Ground action or one of its conditional effects, which adds its
+   * propositions once all of its preconditions are reached.
+   */
+  struct Unit {
+    size_t id_action;
+    std::vector<size_t> pre;
+    std::vector<size_t> add;
+  };
+
+  /**
+   * Builds the relaxed task. The actions must have been grounded with
+   * Pddl::Ground().
+   */
+  explicit RelaxedTask(const Pddl& pddl);
+
+  const Pddl& pddl() const { return *pddl_; }
+
+  size_t num_propositions() const { return is_free_.size(); }
+
+  const std::vector<Unit>& units() const { return units_; }
+
+  /**
+   * Indices of the units with the given proposition as a precondition.
+   */
+  const std::vector<size_t>& watchers(size_t idx_prop) const {
+    return watchers_[idx_prop];
+  }
+
+  /**
+   * Whether the proposition is reached without any actions.
+   */
+  bool is_free(size_t idx_prop) const { return is_free_[idx_prop]; }
+
+  /**
+   * Goal as a disjunction of conjunctions. Only the positive literals are
+   * considered by the relaxation.
+   */
+  const std::vector<GroundConjunction>& goal() const { return goal_; }
+
+ private:
+  const Pddl* pddl_;
+
+  std::vector<Unit> units_;
+  std::vector<std::vector<size_t>> watchers_;
+  std::vector<bool> is_free_;
+  std::vector<GroundConjunction> goal_;
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_PLANNING_RELAXED_TASK_H_
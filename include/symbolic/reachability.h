@@ -0,0 +1,51 @@
+/**
+ * reachability.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_REACHABILITY_H_
+#define SYMBOLIC_REACHABILITY_H_
+
+#include <vector>  // std::vector
+
+#include "symbolic/ground_action.h"
+
+namespace symbolic {
+
+class Pddl;
+
+/**
+ * Propositions and ground actions reachable from the initial state under the
+ * delete relaxation.
+ *
+ * The relaxation ignores delete effects and negative preconditions, so the
+ * reachable sets over-approximate the ones of the real problem: anything
+ * outside of them can never be reached. Derived predicates and propositions
+ * modified by axioms are not compiled into the ground actions and are always
+ * considered reachable.
+ */
+struct Reachability {
+  /**
+   * Computes the relaxed reachability fixpoint.
+   *
+   * @param pddl Pddl object.
+   * @param actions Ground actions, where the id of each action is its index.
+   * @returns Reachable propositions and ground actions.
+   */
+  static Reachability Compute(const Pddl& pddl,
+                              const std::vector<GroundAction>& actions);
+
+  // StateIndex indices of the reachable propositions in increasing order.
+  std::vector<size_t> propositions;
+
+  // Ids of the reachable ground actions in increasing order.
+  std::vector<size_t> actions;
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_REACHABILITY_H_
@@ -0,0 +1,121 @@
+/**
+ * relevance_index.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_RELEVANCE_INDEX_H_
+#define SYMBOLIC_RELEVANCE_INDEX_H_
+
+#include <set>            // std::set
+#include <string>         // std::string
+#include <unordered_map>  // std::unordered_map
+#include <vector>         // std::vector
+
+#include "symbolic/action.h"
+#include "symbolic/ground_action.h"
+
+namespace symbolic {
+
+/**
+ * Actions that are relevant to a predicate or a ground proposition.
+ *
+ * Lifted actions are identified by their index in Pddl::actions() and ground
+ * actions by their id. All lists are sorted in increasing order.
+ */
+struct RelevantActions {
+  // Actions that add it, including in conditional effects.
+  std::vector<size_t> add;
+
+  // Actions that delete it, including in conditional effects.
+  std::vector<size_t> del;
+
+  // Actions whose preconditions require it to be true.
+  std::vector<size_t> pre_pos;
+
+  // Actions whose preconditions require it to be false.
+  std::vector<size_t> pre_neg;
+};
+
+/**
+ * Indexes from predicates, and from ground propositions once the actions have
+ * been grounded, to the actions that add them, delete them or require them.
+ *
+ * Lifted preconditions are scanned in full, so a predicate that appears in a
+ * disjunction or under a quantifier is indexed with the polarity it has there.
+ * Ground preconditions are single conjunctions and are indexed exactly. The
+ * conditions of conditional effects are not indexed as preconditions.
+ */
+class RelevanceIndex {
+ public:
+  RelevanceIndex() = default;
+
+  /**
+   * Indexes the predicates of the lifted actions.
+   *
+   * @param actions Lifted actions, identified by their index.
+   */
+  explicit RelevanceIndex(const std::vector<Action>& actions);
+
+  /**
+   * Indexes the ground propositions of the ground actions, replacing the
+   * previous ground index.
+   *
+   * @param num_propositions Size of the StateIndex.
+   * @param actions Ground actions, where the id of each action is its index.
+   */
+  void IndexGroundActions(size_t num_propositions,
+                          const std::vector<GroundAction>& actions);
+
+  /**
+   * Removes the ground index after the ground actions have been invalidated.
+   */
+  void ClearGroundActions() { propositions_.clear(); }
+
+  /**
+   * Actions relevant to the predicate, which are empty if it doesn't appear in
+   * any action.
+   */
+  const RelevantActions& predicate(const std::string& name_predicate) const;
+
+  /**
+   * Ground actions relevant to the proposition with the given StateIndex
+   * index. The actions must have been indexed with IndexGroundActions().
+   */
+  const RelevantActions& proposition(size_t idx_proposition) const {
+    return propositions_.at(idx_proposition);
+  }
+
+  const std::unordered_map<std::string, RelevantActions>& predicates() const {
+    return predicates_;
+  }
+
+  /**
+   * Ground index by StateIndex proposition index, which is empty if the
+   * ground actions haven't been indexed.
+   */
+  const std::vector<RelevantActions>& propositions() const {
+    return propositions_;
+  }
+
+ private:
+  std::unordered_map<std::string, RelevantActions> predicates_;
+  std::vector<RelevantActions> propositions_;
+};
+
+/**
+ * Collects the names of the predicates added or deleted by the effects,
+ * including the effects nested in universal and conditional effects.
+ *
+ * @param effects Action or axiom postconditions.
+ * @param predicates Set to add the predicate names to.
+ */
+void AddEffectPredicates(const VAL::effect_lists* effects,
+                         std::set<std::string>* predicates);
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_RELEVANCE_INDEX_H_
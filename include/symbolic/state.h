@@ -222,11 +222,29 @@ class StateIndex {
   class iterator;
   using IndexedState = Eigen::Array<bool, Eigen::Dynamic, 1>;
 
+  /**
+   * Batch of indexed states, with one state per row.
+   */
+  using IndexedStates =
+      Eigen::Array<bool, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+  /**
+   * Hash and equality of indexed states for hash tables.
+   */
+  struct IndexedStateHash {
+    size_t operator()(const IndexedState& state) const noexcept;
+  };
+  struct IndexedStateEqual {
+    bool operator()(const IndexedState& lhs, const IndexedState& rhs) const {
+      return lhs.size() == rhs.size() && (lhs == rhs).all();
+    }
+  };
+
   /**
    * Construct the index from the given predicates.
    *
    * @param predicates Pddl predicates.
-   * @param use_cache Cache proposition lookups.
+   * @param use_cache Cache all the propositions and their indices up front.
    */
   explicit StateIndex(const std::vector<Predicate>& predicates,
                       bool use_cache = true);
@@ -287,12 +305,13 @@ class StateIndex {
   // Map from predicate to index in predicates vector
   std::unordered_map<std::string, size_t> idx_predicates_;
 
-  // Cache
-  mutable std::unordered_map<size_t, Proposition> cache_propositions_;
-  mutable std::unordered_map<std::string, size_t> cache_idx_propositions_;
-
   bool use_cache_;
 
+  // Cache of every proposition, which is filled on construction so that
+  // lookups can be made from multiple threads without locking.
+  std::vector<Proposition> cache_propositions_;
+  std::unordered_map<Proposition, size_t> cache_idx_propositions_;
+
  public:
   class iterator {
    public:
@@ -0,0 +1,77 @@
+/**
+ * successor_generator.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_SUCCESSOR_GENERATOR_H_
+#define SYMBOLIC_SUCCESSOR_GENERATOR_H_
+
+#include <vector>  // std::vector
+
+#include "symbolic/ground_action.h"
+#include "symbolic/state.h"
+
+namespace symbolic {
+
+/**
+ * Decision tree over the precondition propositions of ground actions that
+ * returns the ground actions applicable in a state.
+ *
+ * Each internal node tests one proposition and has up to three subtrees: the
+ * actions that require the proposition to be true, the actions that require it
+ * to be false, and the actions that don't care. Actions whose preconditions
+ * have all been tested are stored at the node where the last test happened.
+ * A query only descends into subtrees consistent with the state, so its cost
+ * is roughly proportional to the number of applicable actions.
+ */
+class SuccessorGenerator {
+ public:
+  SuccessorGenerator() = default;
+
+  /**
+   * Builds the decision tree from the ground actions.
+   *
+   * @param actions Ground actions, where the id of each action is its index.
+   */
+  explicit SuccessorGenerator(const std::vector<GroundAction>& actions);
+
+  /**
+   * Returns the ids of the ground actions applicable in the given state in
+   * increasing order.
+   *
+   * @param state Indexed state.
+   * @returns Applicable ground action ids.
+   */
+  std::vector<size_t> GetApplicableActions(
+      const StateIndex::IndexedState& state) const;
+
+  /**
+   * Number of decision tree nodes.
+   */
+  size_t size() const { return nodes_.size(); }
+
+  bool empty() const { return nodes_.empty(); }
+
+ private:
+  struct Node {
+    size_t idx_prop = 0;
+    int idx_true = -1;
+    int idx_false = -1;
+    int idx_dont_care = -1;
+
+    // Range of the actions whose preconditions are satisfied at this node.
+    size_t idx_actions = 0;
+    size_t num_actions = 0;
+  };
+
+  std::vector<Node> nodes_;
+  std::vector<size_t> actions_;
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_SUCCESSOR_GENERATOR_H_
@@ -0,0 +1,151 @@
+/**
+ * undo_log.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_UNDO_LOG_H_
+#define SYMBOLIC_UNDO_LOG_H_
+
+#include <cstddef>        // size_t
+#include <functional>     // std::hash
+#include <unordered_set>  // std::unordered_multiset
+#include <vector>         // std::vector
+
+#include "symbolic/proposition.h"
+#include "symbolic/state.h"
+
+namespace symbolic {
+
+/**
+ * Log of the propositions flipped by in-place state modifications.
+ *
+ * Changes are grouped into frames, each started by Checkpoint(), and Undo()
+ * reverts the most recent frame. Only actual changes are recorded, so each
+ * entry toggles its proposition.
+ *
+ * The log also keeps a hash of the current state relative to the start of the
+ * log, which is the xor of the hashes of the toggled propositions, along with
+ * the hashes at the start of each frame.
+ */
+class UndoLog {
+ public:
+  struct Entry {
+    Proposition prop;
+    bool is_added;
+  };
+
+  /**
+   * Starts a new frame of changes.
+   */
+  void Checkpoint() {
+    frames_.push_back(entries_.size());
+    frame_hashes_.push_back(hash_);
+    path_hashes_.insert(hash_);
+  }
+
+  /**
+   * Records a proposition that was added to or deleted from the state.
+   */
+  void Record(const PropositionBase& prop, bool is_added) {
+    entries_.push_back({Proposition(prop), is_added});
+    hash_ ^= std::hash<Proposition>{}(entries_.back().prop);
+  }
+
+  /**
+   * Reverts the changes recorded since the last checkpoint and removes the
+   * checkpoint.
+   *
+   * @param state State that was modified by the recorded changes.
+   */
+  void Undo(State* state);
+
+  /**
+   * Returns whether the current state is equal to the state at the start of
+   * one of the frames, which means that the frames after it form a cycle.
+   *
+   * The check compares the recorded changes rather than stored states, so it
+   * requires every change to the state to have been recorded. The changes are
+   * only compared if the state hash matches the hash at the start of a frame,
+   * so the check is usually constant time.
+   */
+  bool IsStateRepeated() const;
+
+  /**
+   * Recorded changes in the order they were made.
+   */
+  const std::vector<Entry>& entries() const { return entries_; }
+
+  /**
+   * Index of the first entry of the current frame.
+   */
+  size_t frame_begin() const { return frames_.empty() ? 0 : frames_.back(); }
+
+  /**
+   * Number of frames.
+   */
+  size_t num_frames() const { return frames_.size(); }
+
+  bool empty() const { return frames_.empty(); }
+
+  void clear() {
+    entries_.clear();
+    frames_.clear();
+    frame_hashes_.clear();
+    path_hashes_.clear();
+    hash_ = 0;
+  }
+
+ private:
+  std::vector<Entry> entries_;
+  std::vector<size_t> frames_;
+
+  // State hashes at the start of each frame, in order and as a set.
+  std::vector<size_t> frame_hashes_;
+  std::unordered_multiset<size_t> path_hashes_;
+  size_t hash_ = 0;
+};
+
+/**
+ * State wrapper that records every change into an undo log.
+ *
+ * Used to instantiate the effect functions of actions and derived predicates
+ * for in-place application.
+ */
+class LoggedState {
+ public:
+  LoggedState(State* state, UndoLog* log) : state_(state), log_(log) {}
+
+  bool contains(const PropositionBase& prop) const {
+    return state_->contains(prop);
+  }
+
+  bool insert(const PropositionBase& prop) {
+    if (!state_->insert(prop)) return false;
+    log_->Record(prop, true);
+    return true;
+  }
+
+  bool erase(const PropositionBase& prop) {
+    if (!state_->erase(prop)) return false;
+    log_->Record(prop, false);
+    return true;
+  }
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  operator const State&() const { return *state_; }
+
+  State& state() { return *state_; }
+  UndoLog& log() { return *log_; }
+
+ private:
+  State* state_;
+  UndoLog* log_;
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_UNDO_LOG_H_
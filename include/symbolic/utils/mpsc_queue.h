@@ -0,0 +1,99 @@
+/**
+ * mpsc_queue.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_UTILS_MPSC_QUEUE_H_
+#define SYMBOLIC_UTILS_MPSC_QUEUE_H_
+
+#include <atomic>   // std::atomic
+#include <utility>  // std::move
+#include <vector>   // std::vector
+
+namespace symbolic {
+
+/**
+ * Lock-free multiple-producer single-consumer queue.
+ *
+ * Producers push onto an atomic list head with compare-and-swap, and the
+ * consumer takes the whole list at once with an exchange. Since the consumer
+ * never pops single nodes, the list head doesn't suffer from ABA.
+ */
+template <typename T>
+class MpscQueue {
+ public:
+  MpscQueue() = default;
+
+  ~MpscQueue() {
+    Node* node = head_.load(std::memory_order_acquire);
+    while (node != nullptr) {
+      Node* next = node->next;
+      delete node;
+      node = next;
+    }
+  }
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  /**
+   * Pushes the value. Safe to call from any thread.
+   */
+  void Push(T&& value) {
+    Node* node =
+        new Node{std::move(value), head_.load(std::memory_order_relaxed)};
+    while (!head_.compare_exchange_weak(node->next, node,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+  }
+
+  /**
+   * Moves all of the pushed values to the back of the output in push order.
+   * Must only be called by the consumer.
+   *
+   * @returns Number of values popped.
+   */
+  size_t PopAll(std::vector<T>* values) {
+    Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+
+    // Reverse the list, which is in reverse push order.
+    Node* prev = nullptr;
+    while (node != nullptr) {
+      Node* next = node->next;
+      node->next = prev;
+      prev = node;
+      node = next;
+    }
+
+    size_t num_values = 0;
+    while (prev != nullptr) {
+      values->push_back(std::move(prev->value));
+      Node* next = prev->next;
+      delete prev;
+      prev = next;
+      num_values++;
+    }
+    return num_values;
+  }
+
+  bool empty() const {
+    return head_.load(std::memory_order_acquire) == nullptr;
+  }
+
+ private:
+  struct Node {
+    T value;
+    Node* next;
+  };
+
+  std::atomic<Node*> head_{nullptr};
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_UTILS_MPSC_QUEUE_H_
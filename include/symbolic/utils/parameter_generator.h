@@ -10,6 +10,7 @@
 #ifndef SYMBOLIC_UTILS_PARAMETER_GENERATOR_H_
 #define SYMBOLIC_UTILS_PARAMETER_GENERATOR_H_
 
+#include <functional>     // std::function
 #include <unordered_map>  // std::unordered_map
 #include <vector>         // std::vector
 
@@ -37,6 +38,17 @@ class ParameterGenerator
 
   const Pddl& pddl() const { return *pddl_; }
 
+  /**
+   * Removes the objects that don't pass the filter from the domain of the
+   * given parameter. If the domain becomes empty, the generator produces no
+   * combinations.
+   *
+   * @param idx_param Parameter index.
+   * @param Filter Returns whether the object should be kept.
+   */
+  void Restrict(size_t idx_param,
+                const std::function<bool(const Object&)>& Filter);
+
  private:
   const Pddl* pddl_ = nullptr;
 
@@ -0,0 +1,104 @@
+/**
+ * thread_local_buffer.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_UTILS_THREAD_LOCAL_BUFFER_H_
+#define SYMBOLIC_UTILS_THREAD_LOCAL_BUFFER_H_
+
+#include <cstddef>  // size_t
+#include <deque>    // std::deque
+#include <memory>   // std::make_shared, std::shared_ptr
+#include <mutex>    // std::lock_guard, std::mutex
+#include <utility>  // std::move
+#include <vector>   // std::vector
+
+namespace symbolic {
+
+/**
+ * Scratch buffer with a separate instance in every thread.
+ *
+ * Each thread's instance starts as a copy of the initial value. Copies of the
+ * buffer share the same instances, like copies of a shared pointer would, but
+ * concurrent threads never see each other's writes.
+ */
+template <typename T>
+class ThreadLocalBuffer {
+ public:
+  explicit ThreadLocalBuffer(T value)
+      : slot_(std::make_shared<const Slot>(std::move(value))) {}
+
+  /**
+   * Returns the instance of the calling thread.
+   */
+  T& get() const {
+    // Indexed by slot. A deque keeps references valid while it grows.
+    thread_local std::deque<Instance> instances;
+    const Slot& slot = *slot_;
+    if (slot.idx >= instances.size()) instances.resize(slot.idx + 1);
+
+    // Slots are reused after their buffers are destroyed, so reinitialize
+    // instances left over from a previous buffer.
+    Instance& instance = instances[slot.idx];
+    if (instance.id != slot.id) {
+      instance.id = slot.id;
+      instance.value = slot.value;
+    }
+    return instance.value;
+  }
+
+ private:
+  struct Instance {
+    size_t id = 0;
+    T value;
+  };
+
+  struct Registry {
+    std::mutex mtx;
+    std::vector<size_t> free_slots;
+    size_t num_slots = 0;
+    size_t num_ids = 0;
+  };
+
+  static Registry& registry() {
+    static Registry registry;
+    return registry;
+  }
+
+  struct Slot {
+    explicit Slot(T&& value) : value(std::move(value)) {
+      Registry& r = registry();
+      std::lock_guard<std::mutex> lock(r.mtx);
+      id = ++r.num_ids;
+      if (r.free_slots.empty()) {
+        idx = r.num_slots++;
+      } else {
+        idx = r.free_slots.back();
+        r.free_slots.pop_back();
+      }
+    }
+
+    ~Slot() {
+      Registry& r = registry();
+      std::lock_guard<std::mutex> lock(r.mtx);
+      r.free_slots.push_back(idx);
+    }
+
+    Slot(const Slot&) = delete;
+    Slot& operator=(const Slot&) = delete;
+
+    const T value;
+    size_t idx = 0;
+    size_t id = 0;
+  };
+
+  std::shared_ptr<const Slot> slot_;
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_UTILS_THREAD_LOCAL_BUFFER_H_
@@ -0,0 +1,81 @@
+/**
+ * thread_pool.h
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#ifndef SYMBOLIC_UTILS_THREAD_POOL_H_
+#define SYMBOLIC_UTILS_THREAD_POOL_H_
+
+#include <atomic>              // std::atomic
+#include <condition_variable>  // std::condition_variable
+#include <cstddef>             // size_t
+#include <exception>           // std::exception_ptr
+#include <functional>          // std::function
+#include <mutex>               // std::mutex
+#include <thread>              // std::thread
+#include <vector>              // std::vector
+
+namespace symbolic {
+
+/**
+ * Fixed set of worker threads that run batches of indexed tasks.
+ *
+ * The workers are kept alive between batches so that short batches, such as
+ * listing the valid actions of one state, don't pay for thread creation.
+ */
+class ThreadPool {
+ public:
+  /**
+   * @param num_threads Number of threads that run tasks, including the
+   *                    calling thread. Defaults to the hardware concurrency.
+   */
+  explicit ThreadPool(size_t num_threads = std::thread::hardware_concurrency());
+
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  size_t num_threads() const { return workers_.size() + 1; }
+
+  /**
+   * Calls Task(i) for every i in [0, num_tasks) and blocks until all of them
+   * have finished. The calling thread also runs tasks.
+   *
+   * Tasks may run in any order and concurrently, so they should only write to
+   * disjoint outputs. If a task throws, the remaining tasks are skipped and the
+   * first exception is rethrown.
+   */
+  void Run(size_t num_tasks, const std::function<void(size_t)>& Task);
+
+ private:
+  void Work();
+
+  /**
+   * Runs tasks of the current batch until none are left.
+   */
+  void RunTasks();
+
+  std::vector<std::thread> workers_;
+
+  std::mutex mtx_;
+  std::condition_variable cv_start_;
+  std::condition_variable cv_done_;
+  bool is_terminated_ = false;
+
+  // Current batch, protected by the mutex except for the task counter.
+  const std::function<void(size_t)>* Task_ = nullptr;
+  size_t num_tasks_ = 0;
+  size_t idx_batch_ = 0;
+  size_t num_active_ = 0;
+  std::atomic<size_t> idx_next_task_{0};
+  std::exception_ptr exception_;
+};
+
+}  // namespace symbolic
+
+#endif  // SYMBOLIC_UTILS_THREAD_POOL_H_
@@ -11,10 +11,11 @@
 
 #include <VAL/ptree.h>
 
-#include <algorithm>  // std::max
-#include <cassert>    // assert
-#include <exception>  // std::runtime_error, std::invalid_argument
-#include <sstream>    // std::stringstream
+#include <algorithm>      // std::find, std::max
+#include <cassert>        // assert
+#include <exception>      // std::runtime_error, std::invalid_argument
+#include <sstream>        // std::stringstream
+#include <unordered_set>  // std::unordered_set
 
 #include "symbolic/pddl.h"
 #include "symbolic/utils/parameter_generator.h"
@@ -324,6 +325,34 @@ const VAL::operator_* GetSymbol(const Pddl& pddl,
   return nullptr;
 }
 
+/**
+ * Collects the literals at the top level of the conjunction.
+ */
+void GetConjunctLiterals(
+    const VAL::goal* symbol, bool is_pos,
+    std::vector<std::pair<const VAL::simple_goal*, bool>>* literals) {
+  const auto* simple_goal = dynamic_cast<const VAL::simple_goal*>(symbol);
+  if (simple_goal != nullptr) {
+    literals->emplace_back(simple_goal, is_pos);
+    return;
+  }
+
+  const auto* neg_goal = dynamic_cast<const VAL::neg_goal*>(symbol);
+  if (neg_goal != nullptr) {
+    const auto* goal =
+        dynamic_cast<const VAL::simple_goal*>(neg_goal->getGoal());
+    if (goal != nullptr) literals->emplace_back(goal, !is_pos);
+    return;
+  }
+
+  const auto* conj_goal = dynamic_cast<const VAL::conj_goal*>(symbol);
+  if (is_pos && conj_goal != nullptr) {
+    for (const VAL::goal* goal : *conj_goal->getGoals()) {
+      GetConjunctLiterals(goal, is_pos, literals);
+    }
+  }
+}
+
 }  // namespace
 
 namespace symbolic {
@@ -337,11 +366,53 @@ Action::Action(const Pddl& pddl, const VAL::operator_* symbol)
       Preconditions_(pddl, symbol_->precondition, parameters_),
       Apply_(CreateEffectsFunction<State>(pddl, symbol_->effects, parameters_)),
       ApplyPartial_(CreateEffectsFunction<PartialState>(pddl, symbol_->effects,
-                                                        parameters_)) {}
+                                                        parameters_)),
+      ApplyLogged_(CreateEffectsFunction<LoggedState>(pddl, symbol_->effects,
+                                                      parameters_)) {}
 
 Action::Action(const Pddl& pddl, const std::string& action_call)
     : Action(pddl, GetSymbol(pddl, Proposition::ParseHead(action_call))) {}
 
+ParameterGenerator Action::CreateStaticParameterGenerator() const {
+  ParameterGenerator param_gen = param_gen_;
+  if (symbol_->precondition == nullptr) return param_gen;
+
+  std::vector<std::pair<const VAL::simple_goal*, bool>> literals;
+  GetConjunctLiterals(symbol_->precondition, true, &literals);
+  for (const std::pair<const VAL::simple_goal*, bool>& literal : literals) {
+    const VAL::proposition* prop = literal.first->getProp();
+    const std::string& name_predicate = prop->head->getNameRef();
+    if (!pddl_->IsStatic(name_predicate)) continue;
+
+    const std::vector<Object> prop_params =
+        Object::CreateList(*pddl_, prop->args);
+    if (!literal.second && prop_params.size() != 1) continue;
+
+    for (size_t i = 0; i < prop_params.size(); i++) {
+      const auto it_param =
+          std::find(parameters_.begin(), parameters_.end(), prop_params[i]);
+      if (it_param == parameters_.end()) continue;
+      const size_t idx_param = it_param - parameters_.begin();
+
+      // Collect the objects in position i of the static propositions.
+      std::unordered_set<Object> objects;
+      for (const Proposition& static_prop : pddl_->static_state()) {
+        if (static_prop.name() != name_predicate ||
+            static_prop.arguments().size() != prop_params.size()) {
+          continue;
+        }
+        objects.insert(static_prop.arguments()[i]);
+      }
+
+      const bool is_pos = literal.second;
+      param_gen.Restrict(idx_param, [&objects, is_pos](const Object& object) {
+        return (objects.find(object) != objects.end()) == is_pos;
+      });
+    }
+  }
+  return param_gen;
+}
+
 State Action::Apply(const State& state,
                     const std::vector<Object>& arguments) const {
   State next_state(state);
@@ -349,6 +420,13 @@ State Action::Apply(const State& state,
   return next_state;
 }
 
+bool Action::ApplyInPlace(const std::vector<Object>& arguments, State* state,
+                          UndoLog* log) const {
+  log->Checkpoint();
+  LoggedState logged_state(state, log);
+  return static_cast<bool>(ApplyLogged_(arguments, &logged_state));
+}
+
 PartialState Action::Apply(const PartialState& state,
                            const std::vector<Object>& arguments) const {
   PartialState next_state(state);
@@ -382,33 +460,34 @@ std::pair<Action, std::vector<Object>> Action::Parse(
     const Pddl& pddl, const std::string& action_call) {
   auto aa = std::make_pair(Action(pddl, action_call),
                            Object::ParseArguments(pddl, action_call));
-  const Action& action = aa.first;
-  const std::vector<Object>& args = aa.second;
+  aa.first.CheckArguments(aa.second, action_call);
+  return aa;
+}
 
+void Action::CheckArguments(const std::vector<Object>& args,
+                            const std::string& action_call) const {
   // Check number of arguments
-  if (action.parameters().size() != args.size()) {
+  if (parameters().size() != args.size()) {
     std::stringstream ss;
-    ss << "symbolic::ParseAction(): action " << action << " requires "
-       << action.parameters().size() << " arguments but received "
-       << args.size() << ": " << action_call << ".";
+    ss << "symbolic::ParseAction(): action " << *this << " requires "
+       << parameters().size() << " arguments but received " << args.size()
+       << ": " << action_call << ".";
     throw std::invalid_argument(ss.str());
   }
 
   // Check argument types
-  for (size_t i = 0; i < action.parameters().size(); i++) {
-    const Object& param = action.parameters()[i];
+  for (size_t i = 0; i < parameters().size(); i++) {
+    const Object& param = parameters()[i];
     const Object& arg = args[i];
     if (!arg.type().IsSubtype(param.type())) {
       std::stringstream ss;
-      ss << "symbolic::ParseAction(): action " << action
+      ss << "symbolic::ParseAction(): action " << *this
          << " requires parameter " << param << " to be of type " << param.type()
          << " but received " << arg << " with type " << arg << ": "
          << action_call << ".";
       throw std::invalid_argument(ss.str());
     }
   }
-
-  return aa;
 }
 
 std::ostream& operator<<(std::ostream& os, const Action& action) {
@@ -11,10 +11,12 @@
 
 #include <VAL/ptree.h>
 
+#include <algorithm>  // std::all_of, std::find
 #include <exception>  // std::domain_error
 #include <sstream>    // std::stringstream
 
 #include "symbolic/normal_form.h"
+#include "symbolic/utils/thread_local_buffer.h"
 
 namespace {
 
@@ -115,7 +117,14 @@ Axiom::Axiom(const Pddl& pddl, const VAL::operator_* symbol)
                                   parameters())),
       context_(ExtractContextPredicate(pddl, preconditions())),
       formula_(StringifyFormula(pddl, preconditions(), postconditions(),
-                                parameters())) {}
+                                parameters())) {
+  for (const Object& arg : context_.arguments()) {
+    const auto it = std::find(parameters_.begin(), parameters_.end(), arg);
+    idx_context_params_.push_back(
+        it == parameters_.end() ? -1
+                                : static_cast<int>(it - parameters_.begin()));
+  }
+}
 
 bool Axiom::IsConsistent(const State& state) const {
   State test_state = state;
@@ -203,6 +212,63 @@ bool Axiom::Apply(State* state) const {
   return changed;
 }
 
+bool Axiom::Apply(LoggedState* state) const {
+  bool changed = false;
+  for (const std::vector<Object>& args : arguments_) {
+    // Test if context is valid
+    if (!IsValid(*state, args)) continue;
+
+    // Apply implies
+    changed |= Action::Apply(args, state);
+  }
+  return changed;
+}
+
+bool Axiom::ApplyContext(const PropositionBase& prop,
+                         LoggedState* state) const {
+  const std::vector<Object>& context_args = context_.arguments();
+  if (prop.arguments().size() != context_args.size()) return false;
+
+  // Bind the axiom parameters to the proposition arguments.
+  std::vector<Object> args(parameters_.size());
+  std::vector<bool> is_bound(parameters_.size(), false);
+  for (size_t i = 0; i < context_args.size(); i++) {
+    const Object& arg = prop.arguments()[i];
+    const int idx_param = idx_context_params_[i];
+    if (idx_param < 0) {
+      if (arg != context_args[i]) return false;
+      continue;
+    }
+    if (is_bound[idx_param]) {
+      if (arg != args[idx_param]) return false;
+      continue;
+    }
+    if (!arg.type().IsSubtype(parameters_[idx_param].type())) return false;
+    args[idx_param] = arg;
+    is_bound[idx_param] = true;
+  }
+
+  // Apply directly if the context binds all the parameters.
+  if (std::all_of(is_bound.begin(), is_bound.end(),
+                  [](bool bound) { return bound; })) {
+    if (!IsValid(*state, args)) return false;
+    return Action::Apply(args, state);
+  }
+
+  // Otherwise apply the argument combinations consistent with the binding.
+  bool changed = false;
+  for (const std::vector<Object>& axiom_args : arguments_) {
+    bool is_match = true;
+    for (size_t i = 0; i < args.size() && is_match; i++) {
+      is_match = !is_bound[i] || axiom_args[i] == args[i];
+    }
+    if (!is_match || !IsValid(*state, axiom_args)) continue;
+
+    changed |= Action::Apply(axiom_args, state);
+  }
+  return changed;
+}
+
 PartialState Axiom::Apply(const PartialState& state) const {
   PartialState state_next = state;
   Apply(&state_next);
@@ -243,7 +309,7 @@ std::optional<AxiomApplicationFunction> Axiom::CreateApplicationFunction(
 
   // Check unmatched axiom prop param equal action param.
   std::vector<std::pair<size_t, size_t>> idx_params;
-  auto axiom_args = std::make_shared<std::vector<Object>>(axiom_params);
+  std::vector<Object> axiom_args = axiom_params;
   std::vector<std::pair<size_t, Object>> future_action_args;
   for (size_t idx_prop = 0; idx_prop < num_prop_params; idx_prop++) {
     // Check if axiom prop param has corresponding axiom param.
@@ -270,16 +336,16 @@ std::optional<AxiomApplicationFunction> Axiom::CreateApplicationFunction(
       future_action_args.emplace_back(j, axiom_prop_param);
     } else if (is_action_prop_arg) {
       // Instantiate axiom prop param with action prop arg.
-      (*axiom_args)[i] = action_prop_param;
+      axiom_args[i] = action_prop_param;
     } else {
       // Match axiom prop param and action prop param.
       idx_params.emplace_back(i, j);
     }
   }
 
-  // TODO(tmigimatsu): shared_ptr makes this not thread-safe.
-  return [ptr_axiom_args = std::move(axiom_args),
-          idx_params = std::move(idx_params),
+  // The buffer is thread-local so that actions can be applied concurrently.
+  ThreadLocalBuffer<std::vector<Object>> buffer(std::move(axiom_args));
+  return [buffer = std::move(buffer), idx_params = std::move(idx_params),
           future_action_args = std::move(future_action_args)](
              const std::vector<Object>& action_args)
              -> const std::vector<Object>* {
@@ -291,7 +357,7 @@ std::optional<AxiomApplicationFunction> Axiom::CreateApplicationFunction(
     }
 
     // Assign axiom args to action args.
-    std::vector<Object>& axiom_args = *ptr_axiom_args;
+    std::vector<Object>& axiom_args = buffer.get();
     for (const std::pair<size_t, size_t>& idx_axiom_action : idx_params) {
       const size_t idx_axiom = idx_axiom_action.first;
       const size_t idx_action = idx_axiom_action.second;
@@ -0,0 +1,831 @@
+/**
+ * datalog_program.cc
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#include "symbolic/datalog_program.h"
+
+#include <VAL/ptree.h>
+
+#include <algorithm>   // std::max
+#include <functional>  // std::function
+#include <iterator>    // std::make_move_iterator
+#include <optional>    // std::optional
+#include <utility>     // std::move
+
+#include "symbolic/pddl.h"
+#include "utils/doctest.h"
+
+namespace {
+
+using ::symbolic::DatalogProgram;
+using ::symbolic::Object;
+using ::symbolic::Pddl;
+
+using Literal = DatalogProgram::Literal;
+using Rule = DatalogProgram::Rule;
+
+/**
+ * Rule body under construction.
+ */
+struct Conjunction {
+  std::vector<Object> variables;
+
+  // Indices of the variables in scope of the next literal.
+  std::vector<size_t> scope;
+
+  std::vector<Literal> body;
+};
+
+void AddLiteral(const Pddl& pddl, const VAL::simple_goal* symbol, bool is_pos,
+                Conjunction* conj) {
+  const VAL::proposition* prop = symbol->getProp();
+  const std::string& name_predicate = prop->head->getNameRef();
+
+  Literal literal;
+  if (name_predicate == "=") {
+    literal.type = Literal::Type::kEquality;
+  } else if (pddl.object_map().find(name_predicate) !=
+             pddl.object_map().end()) {
+    literal.type = Literal::Type::kType;
+  } else {
+    literal.type = Literal::Type::kProposition;
+  }
+  literal.is_pos = is_pos;
+  literal.name_predicate = name_predicate;
+  literal.arguments = Object::CreateList(pddl, prop->args);
+  literal.idx_derived = -1;
+
+  // Resolve variables to the innermost scope that declares them.
+  literal.idx_vars.reserve(literal.arguments.size());
+  for (const Object& arg : literal.arguments) {
+    int idx_var = -1;
+    for (auto it = conj->scope.rbegin(); it != conj->scope.rend(); ++it) {
+      if (conj->variables[*it] == arg) {
+        idx_var = static_cast<int>(*it);
+        break;
+      }
+    }
+    literal.idx_vars.push_back(idx_var);
+  }
+
+  conj->body.push_back(std::move(literal));
+}
+
+/**
+ * Adds the goal to every conjunction, splitting them on disjunctions.
+ *
+ * @returns False if the goal contains an unsupported formula.
+ */
+bool Compile(const Pddl& pddl, const VAL::goal* symbol,
+             std::vector<Conjunction>* conjs) {
+  const auto* simple_goal = dynamic_cast<const VAL::simple_goal*>(symbol);
+  if (simple_goal != nullptr) {
+    for (Conjunction& conj : *conjs) AddLiteral(pddl, simple_goal, true, &conj);
+    return true;
+  }
+
+  const auto* neg_goal = dynamic_cast<const VAL::neg_goal*>(symbol);
+  if (neg_goal != nullptr) {
+    const auto* neg_simple_goal =
+        dynamic_cast<const VAL::simple_goal*>(neg_goal->getGoal());
+    if (neg_simple_goal == nullptr) return false;
+    for (Conjunction& conj : *conjs) {
+      AddLiteral(pddl, neg_simple_goal, false, &conj);
+    }
+    return true;
+  }
+
+  const auto* conj_goal = dynamic_cast<const VAL::conj_goal*>(symbol);
+  if (conj_goal != nullptr) {
+    for (const VAL::goal* goal : *conj_goal->getGoals()) {
+      if (!Compile(pddl, goal, conjs)) return false;
+    }
+    return true;
+  }
+
+  const auto* disj_goal = dynamic_cast<const VAL::disj_goal*>(symbol);
+  if (disj_goal != nullptr) {
+    std::vector<Conjunction> disjuncts;
+    for (const VAL::goal* goal : *disj_goal->getGoals()) {
+      std::vector<Conjunction> branch = *conjs;
+      if (!Compile(pddl, goal, &branch)) return false;
+      disjuncts.insert(disjuncts.end(), std::make_move_iterator(branch.begin()),
+                       std::make_move_iterator(branch.end()));
+    }
+    *conjs = std::move(disjuncts);
+    return true;
+  }
+
+  // Existential variables become rule variables in scope of the subgoal.
+  const auto* qfied_goal = dynamic_cast<const VAL::qfied_goal*>(symbol);
+  if (qfied_goal != nullptr &&
+      qfied_goal->getQuantifier() == VAL::quantifier::E_EXISTS) {
+    const std::vector<Object> variables =
+        Object::CreateList(pddl, qfied_goal->getVars());
+    for (Conjunction& conj : *conjs) {
+      for (const Object& var : variables) {
+        conj.scope.push_back(conj.variables.size());
+        conj.variables.push_back(var);
+      }
+    }
+    if (!Compile(pddl, qfied_goal->getGoal(), conjs)) return false;
+    for (Conjunction& conj : *conjs) {
+      conj.scope.resize(conj.scope.size() - variables.size());
+    }
+    return true;
+  }
+
+  return false;
+}
+
+}  // namespace
+
+namespace symbolic {
+
+/**
+ * Overlay of the rule predicates on a state.
+ *
+ * Atoms are looked up directly in the state, and only the changes made since
+ * the previous version are stored per relation, which gives access to both
+ * the current and the previous version of it. Changes made with Insert() and
+ * Erase() are pending on top of the state, while changes recorded with
+ * MarkChanged() were already made to it. The atoms of a relation are only
+ * collected from the state if a join has to enumerate them.
+ */
+class DatalogProgram::Database {
+ public:
+  struct Relation {
+    std::unordered_set<Proposition> added;
+    std::unordered_set<Proposition> removed;
+
+    // Whether the changes have already been made to the state, in which case
+    // the state holds the current version instead of the previous one.
+    bool is_applied = false;
+
+    // Atoms of the relation in the state, collected on first enumeration.
+    mutable std::optional<std::vector<Proposition>> state_atoms;
+  };
+
+  Database(const State& state, const std::unordered_set<std::string>& names)
+      : state_(state) {
+    for (const std::string& name : names) relations_[name];
+  }
+
+  const Relation* relation(const std::string& name) const {
+    const auto it = relations_.find(name);
+    return it == relations_.end() ? nullptr : &it->second;
+  }
+
+  bool Contains(const Proposition& prop, bool is_old) const {
+    const Relation* rel = relation(prop.name());
+    if (rel == nullptr) return false;
+    return Contains(*rel, prop, is_old);
+  }
+
+  /**
+   * Calls f with every atom of the relation until it returns false.
+   */
+  template <typename F>
+  void ForEach(const std::string& name, bool is_old, F&& f) const {
+    const Relation* rel = relation(name);
+    if (rel == nullptr) return;
+    if (!rel->state_atoms.has_value()) {
+      rel->state_atoms.emplace();
+      for (const Proposition& prop : state_) {
+        if (prop.name() == name) rel->state_atoms->push_back(prop);
+      }
+    }
+
+    // The other version differs from the state by the changes, which are
+    // reverted for applied relations.
+    const bool is_state_version = is_old != rel->is_applied;
+    const std::unordered_set<Proposition>& excluded =
+        rel->is_applied ? rel->added : rel->removed;
+    const std::unordered_set<Proposition>& included =
+        rel->is_applied ? rel->removed : rel->added;
+    for (const Proposition& prop : *rel->state_atoms) {
+      if (!is_state_version && excluded.count(prop) > 0) continue;
+      if (!f(prop)) return;
+    }
+    if (is_state_version) return;
+    for (const Proposition& prop : included) {
+      if (!f(prop)) return;
+    }
+  }
+
+  void Insert(const Proposition& prop) {
+    Relation& rel = relations_.at(prop.name());
+    if (!Contains(rel, prop, false)) RecordChange(&rel, prop, true);
+  }
+
+  void Erase(const Proposition& prop) {
+    Relation& rel = relations_.at(prop.name());
+    if (Contains(rel, prop, false)) RecordChange(&rel, prop, false);
+  }
+
+  /**
+   * Records a change that was already made to the state the database was
+   * created from.
+   */
+  void MarkChanged(const Proposition& prop, bool is_added) {
+    const auto it = relations_.find(prop.name());
+    if (it == relations_.end()) return;
+    it->second.is_applied = true;
+    RecordChange(&it->second, prop, is_added);
+  }
+
+ private:
+  bool Contains(const Relation& rel, const Proposition& prop,
+                bool is_old) const {
+    // The state holds the previous version of pending relations and the
+    // current version of applied ones.
+    if (is_old == rel.is_applied) {
+      if (rel.added.count(prop) > 0) return !is_old;
+      if (rel.removed.count(prop) > 0) return is_old;
+    }
+    return state_.contains(prop);
+  }
+
+  static void RecordChange(Relation* rel, const Proposition& prop,
+                           bool is_added) {
+    // A change that reverts an earlier one cancels it.
+    std::unordered_set<Proposition>& reverted =
+        is_added ? rel->removed : rel->added;
+    if (reverted.erase(prop) > 0) return;
+    (is_added ? rel->added : rel->removed).insert(prop);
+  }
+
+  const State& state_;
+  std::unordered_map<std::string, Relation> relations_;
+};
+
+/**
+ * Backtracking join of a rule body over the current or previous version of
+ * the database.
+ *
+ * Positive proposition literals bind variables from the relations, variables
+ * that remain unbound are enumerated over the objects of their types, and the
+ * other literals are checked once all variables are bound.
+ */
+class DatalogProgram::RuleJoin {
+ public:
+  /**
+   * Receives the head arguments of a derivation and returns whether to
+   * continue the join.
+   */
+  using DeriveFunction = std::function<bool(std::vector<Object>&&)>;
+
+  RuleJoin(const Pddl& pddl, const Rule& rule, const Database& db, bool is_old)
+      : pddl_(pddl),
+        rule_(rule),
+        db_(db),
+        is_old_(is_old),
+        arguments_(rule.variables.size()),
+        is_bound_(rule.variables.size(), false) {}
+
+  /**
+   * Calls Derive with the head arguments of every satisfying binding.
+   *
+   * @param idx_delta Proposition literal that is bound to the delta atoms
+   *                  instead of being evaluated, or -1.
+   * @param delta Atoms for the delta literal, of any predicate.
+   * @param head Head arguments to bind before the join, or null.
+   */
+  void Run(int idx_delta, const std::vector<Proposition>* delta,
+           const std::vector<Object>* head, const DeriveFunction& Derive) {
+    idx_delta_ = idx_delta;
+    delta_ = delta;
+    Derive_ = &Derive;
+    is_stopped_ = false;
+    std::fill(is_bound_.begin(), is_bound_.end(), false);
+    trail_.clear();
+
+    if (head != nullptr) {
+      for (size_t i = 0; i < rule_.num_head_vars; i++) {
+        if (!(*head)[i].type().IsSubtype(rule_.variables[i].type())) return;
+        arguments_[i] = (*head)[i];
+        is_bound_[i] = true;
+      }
+    }
+
+    // Join the delta literal first since it has the fewest atoms.
+    positives_.clear();
+    filters_.clear();
+    if (idx_delta >= 0) positives_.push_back(idx_delta);
+    for (size_t i = 0; i < rule_.body.size(); i++) {
+      if (static_cast<int>(i) == idx_delta) continue;
+      const Literal& literal = rule_.body[i];
+      if (literal.type == Literal::Type::kProposition && literal.is_pos) {
+        positives_.push_back(i);
+      } else {
+        filters_.push_back(i);
+      }
+    }
+
+    Join(0);
+  }
+
+ private:
+  void Join(size_t k) {
+    if (k < positives_.size()) {
+      const size_t idx_literal = positives_[k];
+      const Literal& literal = rule_.body[idx_literal];
+      const auto JoinAtom = [this, &literal, k](const Proposition& prop) {
+        const size_t size_trail = trail_.size();
+        if (Unify(literal, prop.arguments())) Join(k + 1);
+        Unbind(size_trail);
+        return !is_stopped_;
+      };
+
+      if (static_cast<int>(idx_literal) == idx_delta_) {
+        for (const Proposition& prop : *delta_) {
+          if (prop.name() != literal.name_predicate) continue;
+          if (!JoinAtom(prop)) return;
+        }
+      } else if (IsBound(literal)) {
+        if (Evaluate(literal)) Join(k + 1);
+      } else {
+        db_.ForEach(literal.name_predicate, is_old_, JoinAtom);
+      }
+      return;
+    }
+
+    // Enumerate the objects of the next unbound variable.
+    for (size_t i = 0; i < is_bound_.size(); i++) {
+      if (is_bound_[i]) continue;
+      const auto it = pddl_.object_map().find(rule_.variables[i].type().name());
+      if (it == pddl_.object_map().end()) return;
+
+      is_bound_[i] = true;
+      for (const Object& obj : it->second) {
+        arguments_[i] = obj;
+        Join(k);
+        if (is_stopped_) break;
+      }
+      is_bound_[i] = false;
+      return;
+    }
+
+    for (const size_t idx_literal : filters_) {
+      const Literal& literal = rule_.body[idx_literal];
+      if (Evaluate(literal) != literal.is_pos) return;
+    }
+
+    is_stopped_ = !(*Derive_)(std::vector<Object>(
+        arguments_.begin(), arguments_.begin() + rule_.num_head_vars));
+  }
+
+  bool IsBound(const Literal& literal) const {
+    for (const int idx_var : literal.idx_vars) {
+      if (idx_var >= 0 && !is_bound_[idx_var]) return false;
+    }
+    return true;
+  }
+
+  bool Unify(const Literal& literal, const std::vector<Object>& atom) {
+    if (atom.size() != literal.idx_vars.size()) return false;
+    for (size_t i = 0; i < atom.size(); i++) {
+      const int idx_var = literal.idx_vars[i];
+      if (idx_var < 0) {
+        if (atom[i] != literal.arguments[i]) return false;
+      } else if (is_bound_[idx_var]) {
+        if (atom[i] != arguments_[idx_var]) return false;
+      } else {
+        if (!atom[i].type().IsSubtype(rule_.variables[idx_var].type())) {
+          return false;
+        }
+        arguments_[idx_var] = atom[i];
+        is_bound_[idx_var] = true;
+        trail_.push_back(idx_var);
+      }
+    }
+    return true;
+  }
+
+  void Unbind(size_t size_trail) {
+    for (; trail_.size() > size_trail; trail_.pop_back()) {
+      is_bound_[trail_.back()] = false;
+    }
+  }
+
+  bool Evaluate(const Literal& literal) const {
+    std::vector<Object> arguments;
+    arguments.reserve(literal.idx_vars.size());
+    for (size_t i = 0; i < literal.idx_vars.size(); i++) {
+      const int idx_var = literal.idx_vars[i];
+      arguments.push_back(idx_var < 0 ? literal.arguments[i]
+                                      : arguments_[idx_var]);
+    }
+
+    switch (literal.type) {
+      case Literal::Type::kEquality:
+        return arguments[0] == arguments[1];
+      case Literal::Type::kType:
+        return arguments[0].type().IsSubtype(literal.name_predicate);
+      case Literal::Type::kProposition:
+        return db_.Contains(
+            Proposition(literal.name_predicate, std::move(arguments)), is_old_);
+    }
+    return false;
+  }
+
+  const Pddl& pddl_;
+  const Rule& rule_;
+  const Database& db_;
+  const bool is_old_;
+
+  std::vector<Object> arguments_;
+  std::vector<bool> is_bound_;
+  std::vector<size_t> trail_;
+
+  std::vector<size_t> positives_;
+  std::vector<size_t> filters_;
+  int idx_delta_ = -1;
+  const std::vector<Proposition>* delta_ = nullptr;
+  const DeriveFunction* Derive_ = nullptr;
+  bool is_stopped_ = false;
+};
+
+DatalogProgram::DatalogProgram(const Pddl& pddl,
+                               const std::vector<DerivedPredicate>& predicates)
+    : pddl_(&pddl) {
+  // Rules with the same head derive the same predicate.
+  for (const DerivedPredicate& pred : predicates) {
+    if (idx_predicates_.emplace(pred.name(), predicates_.size()).second) {
+      predicates_.push_back(pred.name());
+    }
+  }
+
+  for (const DerivedPredicate& pred : predicates) {
+    Conjunction head;
+    head.variables = pred.parameters();
+    for (size_t i = 0; i < head.variables.size(); i++) head.scope.push_back(i);
+
+    std::vector<Conjunction> conjs = {std::move(head)};
+    if (!Compile(pddl, pred.symbol()->get_body(), &conjs)) {
+      rules_.clear();
+      return;
+    }
+
+    for (Conjunction& conj : conjs) {
+      for (Literal& literal : conj.body) {
+        if (literal.type != Literal::Type::kProposition) continue;
+        relations_.insert(literal.name_predicate);
+        const auto it = idx_predicates_.find(literal.name_predicate);
+        if (it != idx_predicates_.end()) {
+          literal.idx_derived = static_cast<int>(it->second);
+        }
+      }
+      rules_.push_back({idx_predicates_.at(pred.name()),
+                        std::move(conj.variables), pred.parameters().size(),
+                        std::move(conj.body)});
+    }
+  }
+  relations_.insert(predicates_.begin(), predicates_.end());
+
+  is_compiled_ = Stratify();
+}
+
+bool DatalogProgram::Stratify() {
+  // Raise the strata until every dependency is satisfied. Negative
+  // dependencies need a strictly higher stratum, so a stratum beyond the
+  // number of predicates means that there's a cycle through negation.
+  const size_t num_predicates = predicates_.size();
+  idx_strata_.assign(num_predicates, 0);
+  bool is_changed = true;
+  while (is_changed) {
+    is_changed = false;
+    for (const Rule& rule : rules_) {
+      for (const Literal& literal : rule.body) {
+        if (literal.type != Literal::Type::kProposition ||
+            literal.idx_derived < 0) {
+          continue;
+        }
+        const size_t idx_min =
+            idx_strata_[literal.idx_derived] + (literal.is_pos ? 0 : 1);
+        if (idx_strata_[rule.idx_head] >= idx_min) continue;
+        if (idx_min >= num_predicates) return false;
+        idx_strata_[rule.idx_head] = idx_min;
+        is_changed = true;
+      }
+    }
+  }
+
+  size_t num_strata = 0;
+  for (const size_t idx_stratum : idx_strata_) {
+    num_strata = std::max(num_strata, idx_stratum + 1);
+  }
+  strata_.assign(num_strata, {});
+  stratum_rules_.assign(num_strata, {});
+  for (size_t i = 0; i < num_predicates; i++) {
+    strata_[idx_strata_[i]].push_back(i);
+  }
+  for (size_t i = 0; i < rules_.size(); i++) {
+    stratum_rules_[idx_strata_[rules_[i].idx_head]].push_back(i);
+  }
+  return true;
+}
+
+bool DatalogProgram::Apply(State* state) const { return ApplyProgram(state); }
+
+bool DatalogProgram::Apply(State* state, UndoLog* log) const {
+  LoggedState logged_state(state, log);
+  return ApplyProgram(&logged_state);
+}
+
+bool DatalogProgram::Update(State* state,
+                            const std::vector<UndoLog::Entry>& changes) const {
+  return UpdateProgram(state, changes);
+}
+
+bool DatalogProgram::Update(State* state, UndoLog* log) const {
+  // Copy the changes since the derived changes are appended to the same log.
+  const std::vector<UndoLog::Entry> changes(
+      log->entries().begin() + log->frame_begin(), log->entries().end());
+  LoggedState logged_state(state, log);
+  return UpdateProgram(&logged_state, changes);
+}
+
+template <typename T>
+bool DatalogProgram::ApplyProgram(T* state) const {
+  Database db(*state, relations_);
+  for (size_t idx_stratum = 0; idx_stratum < strata_.size(); idx_stratum++) {
+    EvaluateStratum(idx_stratum, &db);
+  }
+  return ApplyChanges(db, state);
+}
+
+template <typename T>
+bool DatalogProgram::UpdateProgram(
+    T* state, const std::vector<UndoLog::Entry>& changes) const {
+  // Skip indexing the state if none of the rules depend on the changes.
+  const auto IsRelevant = [this](const UndoLog::Entry& change) {
+    const std::string& name = change.prop.name();
+    return relations_.count(name) > 0 && idx_predicates_.count(name) == 0;
+  };
+  if (std::none_of(changes.begin(), changes.end(), IsRelevant)) return false;
+
+  Database db(*state, relations_);
+  for (const UndoLog::Entry& change : changes) {
+    if (IsRelevant(change)) db.MarkChanged(change.prop, change.is_added);
+  }
+  for (size_t idx_stratum = 0; idx_stratum < strata_.size(); idx_stratum++) {
+    UpdateStratum(idx_stratum, &db);
+  }
+  return ApplyChanges(db, state);
+}
+
+template <typename T>
+bool DatalogProgram::ApplyChanges(const Database& db, T* state) const {
+  bool is_changed = false;
+  for (const std::string& name_predicate : predicates_) {
+    const Database::Relation& rel = *db.relation(name_predicate);
+    for (const Proposition& prop : rel.removed) {
+      is_changed |= state->erase(prop);
+    }
+    for (const Proposition& prop : rel.added) {
+      is_changed |= state->insert(prop);
+    }
+  }
+  return is_changed;
+}
+
+void DatalogProgram::EvaluateStratum(size_t idx_stratum, Database* db) const {
+  // Clear the stratum so that its rules are evaluated from scratch.
+  for (const size_t idx_pred : strata_[idx_stratum]) {
+    std::vector<Proposition> atoms;
+    db->ForEach(predicates_[idx_pred], false,
+                [&atoms](const Proposition& prop) {
+                  atoms.push_back(prop);
+                  return true;
+                });
+    for (const Proposition& prop : atoms) db->Erase(prop);
+  }
+
+  // Insertions are deferred until the end of the round so that the relations
+  // aren't modified while they are being joined.
+  std::vector<Proposition> frontier;
+  std::unordered_set<Proposition> pending;
+  for (const size_t idx_rule : stratum_rules_[idx_stratum]) {
+    const Rule& rule = rules_[idx_rule];
+    const std::string& name_predicate = predicates_[rule.idx_head];
+    RuleJoin(*pddl_, rule, *db, false)
+        .Run(-1, nullptr, nullptr,
+             [&name_predicate, &frontier,
+              &pending](std::vector<Object>&& arguments) {
+               Proposition prop(name_predicate, std::move(arguments));
+               if (pending.insert(prop).second) {
+                 frontier.push_back(std::move(prop));
+               }
+               return true;
+             });
+  }
+  for (const Proposition& prop : frontier) db->Insert(prop);
+
+  Propagate(idx_stratum, std::move(frontier), db);
+}
+
+void DatalogProgram::UpdateStratum(size_t idx_stratum, Database* db) const {
+  const std::vector<size_t>& idx_rules = stratum_rules_[idx_stratum];
+  const auto IsRecursive = [this, idx_stratum](const Literal& literal) {
+    return literal.idx_derived >= 0 &&
+           idx_strata_[literal.idx_derived] == idx_stratum;
+  };
+
+  // Joins each literal of a lower stratum with its changes. Changes that can
+  // remove a derivation are deletions of positive literals and insertions of
+  // negative ones, and the other way around for changes that can add one.
+  const auto JoinChanges = [this, db, &idx_rules, &IsRecursive](
+                               bool is_deletion, bool is_old,
+                               const std::function<RuleJoin::DeriveFunction(
+                                   const std::string&)>& CreateDerive) {
+    for (const size_t idx_rule : idx_rules) {
+      const Rule& rule = rules_[idx_rule];
+      const RuleJoin::DeriveFunction Derive =
+          CreateDerive(predicates_[rule.idx_head]);
+      for (size_t i = 0; i < rule.body.size(); i++) {
+        const Literal& literal = rule.body[i];
+        if (literal.type != Literal::Type::kProposition ||
+            IsRecursive(literal)) {
+          continue;
+        }
+        const Database::Relation& rel = *db->relation(literal.name_predicate);
+        const std::unordered_set<Proposition>& changes =
+            literal.is_pos == is_deletion ? rel.removed : rel.added;
+        if (changes.empty()) continue;
+
+        const std::vector<Proposition> delta(changes.begin(), changes.end());
+        RuleJoin(*pddl_, rule, *db, is_old)
+            .Run(static_cast<int>(i), &delta, nullptr, Derive);
+      }
+    }
+  };
+
+  // Over-delete every atom with a derivation in the previous database that
+  // used a deleted atom.
+  std::unordered_set<Proposition> deleted;
+  std::vector<Proposition> frontier;
+  const auto CreateOverdelete = [db, &deleted, &frontier](
+                                    const std::string& name_predicate) {
+    return [db, &name_predicate, &deleted,
+            &frontier](std::vector<Object>&& arguments) {
+      Proposition prop(name_predicate, std::move(arguments));
+      if (db->Contains(prop, true) && deleted.insert(prop).second) {
+        frontier.push_back(std::move(prop));
+      }
+      return true;
+    };
+  };
+  JoinChanges(true, true, CreateOverdelete);
+  while (!frontier.empty()) {
+    const std::vector<Proposition> delta = std::move(frontier);
+    frontier.clear();
+    for (const size_t idx_rule : idx_rules) {
+      const Rule& rule = rules_[idx_rule];
+      const RuleJoin::DeriveFunction Overdelete =
+          CreateOverdelete(predicates_[rule.idx_head]);
+      for (size_t i = 0; i < rule.body.size(); i++) {
+        const Literal& literal = rule.body[i];
+        if (!literal.is_pos || !IsRecursive(literal)) continue;
+        RuleJoin(*pddl_, rule, *db, true)
+            .Run(static_cast<int>(i), &delta, nullptr, Overdelete);
+      }
+    }
+  }
+  for (const Proposition& prop : deleted) db->Erase(prop);
+
+  // Rederive the deleted atoms that still have a derivation.
+  std::unordered_set<Proposition> pending;
+  for (const Proposition& prop : deleted) {
+    bool is_derivable = false;
+    for (const size_t idx_rule : idx_rules) {
+      const Rule& rule = rules_[idx_rule];
+      if (predicates_[rule.idx_head] != prop.name()) continue;
+      RuleJoin(*pddl_, rule, *db, false)
+          .Run(-1, nullptr, &prop.arguments(),
+               [&is_derivable](std::vector<Object>&&) {
+                 is_derivable = true;
+                 return false;
+               });
+      if (is_derivable) break;
+    }
+    if (!is_derivable) continue;
+    pending.insert(prop);
+    frontier.push_back(prop);
+  }
+
+  // Insert the atoms with a new derivation that uses an inserted atom.
+  JoinChanges(false, false, [db, &pending, &frontier](
+                                const std::string& name_predicate) {
+    return [db, &name_predicate, &pending,
+            &frontier](std::vector<Object>&& arguments) {
+      Proposition prop(name_predicate, std::move(arguments));
+      if (!db->Contains(prop, false) && pending.insert(prop).second) {
+        frontier.push_back(std::move(prop));
+      }
+      return true;
+    };
+  });
+  for (const Proposition& prop : frontier) db->Insert(prop);
+
+  Propagate(idx_stratum, std::move(frontier), db);
+}
+
+void DatalogProgram::Propagate(size_t idx_stratum,
+                               std::vector<Proposition>&& frontier,
+                               Database* db) const {
+  while (!frontier.empty()) {
+    const std::vector<Proposition> delta = std::move(frontier);
+    frontier.clear();
+    std::unordered_set<Proposition> pending;
+    for (const size_t idx_rule : stratum_rules_[idx_stratum]) {
+      const Rule& rule = rules_[idx_rule];
+      const std::string& name_predicate = predicates_[rule.idx_head];
+      const RuleJoin::DeriveFunction Derive =
+          [db, &name_predicate, &pending,
+           &frontier](std::vector<Object>&& arguments) {
+            Proposition prop(name_predicate, std::move(arguments));
+            if (!db->Contains(prop, false) && pending.insert(prop).second) {
+              frontier.push_back(std::move(prop));
+            }
+            return true;
+          };
+      for (size_t i = 0; i < rule.body.size(); i++) {
+        const Literal& literal = rule.body[i];
+        if (literal.type != Literal::Type::kProposition || !literal.is_pos ||
+            literal.idx_derived < 0 ||
+            idx_strata_[literal.idx_derived] != idx_stratum) {
+          continue;
+        }
+        RuleJoin(*pddl_, rule, *db, false)
+            .Run(static_cast<int>(i), &delta, nullptr, Derive);
+      }
+    }
+    for (const Proposition& prop : frontier) db->Insert(prop);
+  }
+}
+
+TEST_CASE_FIXTURE(testing::DerivedFixture, "DatalogProgram.Apply") {
+  const DatalogProgram& program = pddl.derived_program();
+  REQUIRE(program.is_compiled());
+
+  // clear negates covered, so it's evaluated in a higher stratum.
+  REQUIRE(program.strata().size() == 2);
+  REQUIRE((program.strata().back() == std::vector<size_t>{2}));
+
+  const State state(pddl,
+                    {"on(a, b)", "on(b, c)", "ontable(c)", "ontable(d)"});
+  const State expected =
+      DerivedPredicate::Apply(state, pddl.derived_predicates());
+  REQUIRE((expected == State(pddl, {"on(a, b)", "on(b, c)", "ontable(c)",
+                                    "ontable(d)", "above(a, b)", "above(b, c)",
+                                    "above(a, c)", "covered(b)", "covered(c)",
+                                    "clear(a)", "clear(d)"})));
+
+  State derived = state;
+  REQUIRE(program.Apply(&derived));
+  REQUIRE(derived == expected);
+  REQUIRE(!program.Apply(&derived));
+
+  // Stale derived propositions are recomputed.
+  State stale = expected;
+  stale.insert(Proposition(pddl, "above(c, a)"));
+  stale.erase(Proposition(pddl, "clear(a)"));
+  REQUIRE(program.Apply(&stale));
+  REQUIRE(stale == expected);
+
+  // The changes recorded in the undo log restore the state.
+  State logged = state;
+  UndoLog log;
+  log.Checkpoint();
+  REQUIRE(program.Apply(&logged, &log));
+  REQUIRE(logged == expected);
+  log.Undo(&logged);
+  REQUIRE(logged == state);
+}
+
+TEST_CASE_FIXTURE(testing::DerivedCycleFixture, "DatalogProgram.Cycle") {
+  // p and q negate each other, so the program can't be stratified.
+  REQUIRE(!pddl.derived_program().is_compiled());
+
+  // Pddl falls back to applying the derived predicates directly.
+  const State state(pddl, {"marked(x)"});
+  const State expected =
+      DerivedPredicate::Apply(state, pddl.derived_predicates());
+  REQUIRE((expected == State(pddl, {"marked(x)", "p(x)", "p(y)"})));
+  REQUIRE(pddl.DerivedState(state) == expected);
+
+  State next_state = pddl.initial_state();
+  REQUIRE(pddl.ApplyAction(pddl.actions().front(), {Object(pddl, "y")},
+                           &next_state));
+  REQUIRE(next_state ==
+          DerivedPredicate::Apply(State(pddl, {"marked(x)", "marked(y)"}),
+                                  pddl.derived_predicates()));
+}
+
+}  // namespace symbolic
@@ -11,50 +11,78 @@
 
 #include <VAL/ptree.h>
 
+#include <utility>  // std::move
+
 #include "symbolic/pddl.h"
 
-namespace symbolic {
+namespace {
 
-DerivedPredicate::DerivedPredicate(const Pddl& pddl,
-                                   const VAL::derivation_rule* symbol)
-    : symbol_(symbol) {
-  name_ = symbol_->get_head()->head->getName();
-  parameters_ = Object::CreateList(pddl, symbol_->get_head()->args);
-  param_gen_ = ParameterGenerator(pddl, parameters_);
-  Preconditions_ = Formula(pddl, symbol_->get_body(), parameters_);
-}
+using ::symbolic::DerivedPredicate;
+using ::symbolic::Object;
+using ::symbolic::Proposition;
 
-bool DerivedPredicate::Apply(State* state) const {
+template <typename T>
+bool ApplyDerivedPredicate(const DerivedPredicate& pred, T* state) {
   bool is_changed = false;
   bool is_iter_changed = true;
   while (is_iter_changed) {
     // Keep iterating until predicate converges
     is_iter_changed = false;
-    for (const std::vector<Object>& arguments : parameter_generator()) {
-      is_iter_changed |= IsValid(*state, arguments)
-                             ? state->emplace(name(), arguments)
-                             : state->erase(Proposition(name(), arguments));
+    for (const std::vector<Object>& arguments : pred.parameter_generator()) {
+      Proposition prop(pred.name(), arguments);
+      is_iter_changed |= pred.IsValid(*state, arguments)
+                             ? state->insert(std::move(prop))
+                             : state->erase(prop);
     }
     is_changed |= is_iter_changed;
   }
   return is_changed;
 }
 
-bool DerivedPredicate::Apply(const std::vector<DerivedPredicate>& predicates,
-                             State* state) {
+template <typename T>
+bool ApplyDerivedPredicates(const std::vector<DerivedPredicate>& predicates,
+                            T* state) {
   bool is_changed = false;
   bool is_iter_changed = true;
   while (is_iter_changed) {
     // Keep iterating until predicates converge
     is_iter_changed = false;
     for (const DerivedPredicate& pred : predicates) {
-      is_iter_changed |= pred.Apply(state);
+      is_iter_changed |= ApplyDerivedPredicate(pred, state);
     }
     is_changed |= is_iter_changed;
   }
   return is_changed;
 }
 
+}  // namespace
+
+namespace symbolic {
+
+DerivedPredicate::DerivedPredicate(const Pddl& pddl,
+                                   const VAL::derivation_rule* symbol)
+    : symbol_(symbol) {
+  name_ = symbol_->get_head()->head->getName();
+  parameters_ = Object::CreateList(pddl, symbol_->get_head()->args);
+  param_gen_ = ParameterGenerator(pddl, parameters_);
+  Preconditions_ = Formula(pddl, symbol_->get_body(), parameters_);
+}
+
+bool DerivedPredicate::Apply(State* state) const {
+  return ApplyDerivedPredicate(*this, state);
+}
+
+bool DerivedPredicate::Apply(const std::vector<DerivedPredicate>& predicates,
+                             State* state) {
+  return ApplyDerivedPredicates(predicates, state);
+}
+
+bool DerivedPredicate::Apply(const std::vector<DerivedPredicate>& predicates,
+                             State* state, UndoLog* log) {
+  LoggedState logged_state(state, log);
+  return ApplyDerivedPredicates(predicates, &logged_state);
+}
+
 State DerivedPredicate::Apply(const State& state,
                               const std::vector<DerivedPredicate>& predicates) {
   State next_state = state;
@@ -11,6 +11,8 @@
 
 #include <VAL/ptree.h>
 
+#include <algorithm>      // std::stable_sort
+#include <atomic>         // std::atomic
 #include <cassert>        // assert
 #include <exception>      // std::runtime_error
 #include <sstream>        // std::stringstream
@@ -18,10 +20,13 @@
 #include <utility>        // std::move
 
 #include "symbolic/pddl.h"
+#include "symbolic/utils/thread_local_buffer.h"
+#include "utils/doctest.h"
 
 namespace {
 
 using ::symbolic::Formula;
+using ::symbolic::LiteralConjunction;
 using ::symbolic::Object;
 using ::symbolic::ParameterGenerator;
 using ::symbolic::PartialState;
@@ -340,20 +345,379 @@ NamedFormulaFunction<T> CreateFormula(const Pddl& pddl, const VAL::goal* symbol,
   throw std::runtime_error("GetFormula(): Goal type not implemented.");
 }
 
+/**
+ * Returns whether the goal is a (possibly nested) conjunction of literals.
+ */
+bool IsLiteralConjunction(const VAL::goal* symbol) {
+  if (dynamic_cast<const VAL::simple_goal*>(symbol) != nullptr) return true;
+
+  const auto* neg_goal = dynamic_cast<const VAL::neg_goal*>(symbol);
+  if (neg_goal != nullptr) {
+    return dynamic_cast<const VAL::simple_goal*>(neg_goal->getGoal()) != nullptr;
+  }
+
+  const auto* conj_goal = dynamic_cast<const VAL::conj_goal*>(symbol);
+  if (conj_goal == nullptr) return false;
+  for (const VAL::goal* goal : *conj_goal->getGoals()) {
+    if (!IsLiteralConjunction(goal)) return false;
+  }
+  return true;
+}
+
+/**
+ * Throws if the order is not a permutation of [0, size).
+ */
+void CheckPermutation(const std::vector<size_t>& order, size_t size,
+                      const std::string& method) {
+  std::vector<bool> visited(size, false);
+  if (order.size() != size) {
+    throw std::runtime_error(method + ": Order must have size " +
+                             std::to_string(size) + ".");
+  }
+  for (const size_t idx : order) {
+    if (idx >= size || visited[idx]) {
+      throw std::runtime_error(method + ": Order is not a permutation.");
+    }
+    visited[idx] = true;
+  }
+}
+
 }  // namespace
 
 namespace symbolic {
 
+class Formula::Profile {
+ public:
+  explicit Profile(size_t size) : num_evaluated(size), num_failed(size) {}
+
+  std::vector<std::atomic<size_t>> num_evaluated;
+  std::vector<std::atomic<size_t>> num_failed;
+};
+
+std::optional<LiteralConjunction> LiteralConjunction::Create(
+    const Pddl& pddl, const VAL::goal* symbol,
+    const std::vector<Object>& parameters) {
+  if (symbol == nullptr || !IsLiteralConjunction(symbol)) return {};
+
+  LiteralConjunction conj;
+  std::vector<const VAL::goal*> stack = {symbol};
+  while (!stack.empty()) {
+    const VAL::goal* goal = stack.back();
+    stack.pop_back();
+
+    const auto* simple_goal = dynamic_cast<const VAL::simple_goal*>(goal);
+    if (simple_goal != nullptr) {
+      conj.AddLiteral(pddl, simple_goal, parameters, true);
+      continue;
+    }
+
+    const auto* neg_goal = dynamic_cast<const VAL::neg_goal*>(goal);
+    if (neg_goal != nullptr) {
+      conj.AddLiteral(
+          pddl, dynamic_cast<const VAL::simple_goal*>(neg_goal->getGoal()),
+          parameters, false);
+      continue;
+    }
+
+    // Push subgoals in reverse to preserve the order of the formula.
+    const VAL::goal_list* goals =
+        dynamic_cast<const VAL::conj_goal*>(goal)->getGoals();
+    stack.insert(stack.end(), goals->rbegin(), goals->rend());
+  }
+  return conj;
+}
+
+void LiteralConjunction::AddLiteral(const Pddl& pddl,
+                                    const VAL::simple_goal* symbol,
+                                    const std::vector<Object>& parameters,
+                                    bool is_pos) {
+  const VAL::proposition* prop = symbol->getProp();
+  const std::string& name_predicate = prop->head->getNameRef();
+  const std::vector<Object> prop_params = Object::CreateList(pddl, prop->args);
+
+  Literal literal;
+  literal.name_predicate = &name_predicate;
+  literal.predicate_hash = std::hash<std::string>{}(name_predicate);
+  literal.is_pos = is_pos;
+  literal.idx_source = literals_.size();
+  literal.idx_slot = slot_params_.size();
+  literal.num_slots = prop_params.size();
+  if (name_predicate == "=") {
+    literal.type = Type::kEquality;
+  } else if (pddl.object_map().find(name_predicate) !=
+             pddl.object_map().end()) {
+    literal.type = Type::kType;
+  } else {
+    literal.type = Type::kProposition;
+  }
+  literals_.push_back(literal);
+
+  // Same parameter mapping as Formula::CreateApplicationFunction().
+  for (const Object& prop_param : prop_params) {
+    int idx_param = -1;
+    for (size_t j = 0; j < parameters.size(); j++) {
+      if (prop_param == parameters[j]) idx_param = static_cast<int>(j);
+    }
+    slot_params_.push_back(idx_param);
+    slot_objects_.push_back(prop_param);
+  }
+}
+
+bool LiteralConjunction::Evaluate(const Literal& literal, const State& state,
+                                  const std::vector<Object>& arguments) const {
+  switch (literal.type) {
+    case Type::kEquality:
+      assert(literal.num_slots == 2);
+      return Slot(literal.idx_slot, arguments) ==
+             Slot(literal.idx_slot + 1, arguments);
+    case Type::kType:
+      assert(literal.num_slots == 1);
+      return Slot(literal.idx_slot, arguments)
+          .type()
+          .IsSubtype(*literal.name_predicate);
+    case Type::kProposition:
+      break;
+  }
+
+  // Scratch buffer for the proposition arguments.
+  thread_local std::vector<Object> prop_args;
+  prop_args.resize(literal.num_slots);
+  for (size_t i = 0; i < literal.num_slots; i++) {
+    prop_args[i] = Slot(literal.idx_slot + i, arguments);
+  }
+  const PropositionRef P(literal.name_predicate, &prop_args,
+                         literal.predicate_hash);
+  return state.contains(P);
+}
+
+void LiteralConjunction::Reorder(const std::vector<size_t>& order) {
+  std::vector<size_t> idx_literals(literals_.size());
+  for (size_t i = 0; i < literals_.size(); i++) {
+    idx_literals[literals_[i].idx_source] = i;
+  }
+
+  // Rebuild the slot arrays so that they stay contiguous in evaluation order.
+  std::vector<Literal> literals;
+  std::vector<int> slot_params;
+  std::vector<Object> slot_objects;
+  literals.reserve(literals_.size());
+  slot_params.reserve(slot_params_.size());
+  slot_objects.reserve(slot_objects_.size());
+  for (const size_t idx_source : order) {
+    Literal literal = literals_.at(idx_literals.at(idx_source));
+    const size_t idx_slot = literal.idx_slot;
+    literal.idx_slot = slot_params.size();
+    for (size_t i = 0; i < literal.num_slots; i++) {
+      slot_params.push_back(slot_params_[idx_slot + i]);
+      slot_objects.push_back(slot_objects_[idx_slot + i]);
+    }
+    literals.push_back(literal);
+  }
+
+  literals_ = std::move(literals);
+  slot_params_ = std::move(slot_params);
+  slot_objects_ = std::move(slot_objects);
+}
+
+std::vector<Object> LiteralConjunction::Arguments(
+    const Literal& literal, const std::vector<Object>& arguments) const {
+  std::vector<Object> prop_args;
+  prop_args.reserve(literal.num_slots);
+  for (size_t i = 0; i < literal.num_slots; i++) {
+    prop_args.push_back(Slot(literal.idx_slot + i, arguments));
+  }
+  return prop_args;
+}
+
 Formula::Formula(const Pddl& pddl, const VAL::goal* symbol,
                  const std::vector<Object>& parameters)
     : symbol_(symbol),
-      P_(CreateFormula<State>(pddl, symbol, parameters).first) {
+      literals_(LiteralConjunction::Create(pddl, symbol, parameters)) {
+  // Fall back to the general formula tree for the top-level conjuncts.
+  if (!literals_ && symbol != nullptr) {
+    const auto* conj_goal = dynamic_cast<const VAL::conj_goal*>(symbol);
+    if (conj_goal != nullptr) {
+      for (const VAL::goal* goal : *conj_goal->getGoals()) {
+        conjuncts_.push_back(
+            {CreateFormula<State>(pddl, goal, parameters).first,
+             conjuncts_.size()});
+      }
+    } else {
+      conjuncts_.push_back(
+          {CreateFormula<State>(pddl, symbol, parameters).first, 0});
+    }
+  }
+
   NamedFormulaFunction<PartialState> pp_str =
       CreateFormula<PartialState>(pddl, symbol, parameters);
   PP_ = pp_str.first;
   str_formula_ = pp_str.second;
 }
 
+TEST_CASE_FIXTURE(testing::Fixture, "Formula.LiteralConjunction") {
+  const Action& pick = pddl.actions()[0];
+  const Action& place = pddl.actions()[1];
+  REQUIRE(pick.preconditions().literal_conjunction() == nullptr);
+  REQUIRE(place.preconditions().literal_conjunction() != nullptr);
+  REQUIRE(place.preconditions().literal_conjunction()->size() == 3);
+  REQUIRE(pddl.goal().literal_conjunction() != nullptr);
+
+  const State state = pddl.NextState(pddl.initial_state(), "pick(box)");
+  REQUIRE(pddl.IsValidAction(state, "place(box, shelf)") == true);
+  REQUIRE(pddl.IsValidAction(state, "place(box, box)") == false);
+  REQUIRE(pddl.IsValidAction(state, "place(hook, shelf)") == false);
+  REQUIRE(pddl.IsGoalSatisfied(state) == false);
+  REQUIRE(pddl.IsGoalSatisfied(pddl.NextState(state, "place(box, shelf)")) ==
+          true);
+}
+
+bool Formula::EvaluateProfiled(const State& state,
+                               const std::vector<Object>& arguments) const {
+  Profile& profile = *profile_;
+  if (literals_) {
+    for (const LiteralConjunction::Literal& literal : literals_->literals()) {
+      const size_t idx = literal.idx_source;
+      profile.num_evaluated[idx].fetch_add(1, std::memory_order_relaxed);
+      if (literals_->Evaluate(literal, state, arguments) != literal.is_pos) {
+        profile.num_failed[idx].fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+    }
+    return true;
+  }
+
+  for (const Conjunct& conjunct : conjuncts_) {
+    const size_t idx = conjunct.idx_source;
+    profile.num_evaluated[idx].fetch_add(1, std::memory_order_relaxed);
+    if (!conjunct.P(state, arguments)) {
+      profile.num_failed[idx].fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t Formula::CountUnsatisfied(const State& state,
+                                 const std::vector<Object>& arguments,
+                                 std::vector<bool>* satisfied) const {
+  if (satisfied != nullptr) satisfied->assign(num_conjuncts(), false);
+
+  size_t num_unsatisfied = 0;
+  if (literals_) {
+    for (const LiteralConjunction::Literal& literal : literals_->literals()) {
+      const bool is_true =
+          literals_->Evaluate(literal, state, arguments) == literal.is_pos;
+      if (!is_true) num_unsatisfied++;
+      if (satisfied != nullptr) (*satisfied)[literal.idx_source] = is_true;
+    }
+    return num_unsatisfied;
+  }
+
+  for (const Conjunct& conjunct : conjuncts_) {
+    const bool is_true = conjunct.P(state, arguments);
+    if (!is_true) num_unsatisfied++;
+    if (satisfied != nullptr) (*satisfied)[conjunct.idx_source] = is_true;
+  }
+  return num_unsatisfied;
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "Formula.CountUnsatisfied") {
+  std::vector<bool> satisfied;
+  REQUIRE(pddl.goal().CountUnsatisfied(pddl.initial_state(), &satisfied) == 1);
+  REQUIRE((satisfied == std::vector<bool>{true, true, false}));
+
+  const State state = pddl.NextState(pddl.initial_state(), "pick(box)");
+  REQUIRE(pddl.goal().CountUnsatisfied(state, &satisfied) == 2);
+  REQUIRE((satisfied == std::vector<bool>{true, false, false}));
+}
+
+std::vector<size_t> Formula::conjunct_order() const {
+  std::vector<size_t> order;
+  order.reserve(num_conjuncts());
+  if (literals_) {
+    for (const LiteralConjunction::Literal& literal : literals_->literals()) {
+      order.push_back(literal.idx_source);
+    }
+  } else {
+    for (const Conjunct& conjunct : conjuncts_) {
+      order.push_back(conjunct.idx_source);
+    }
+  }
+  return order;
+}
+
+void Formula::ReorderConjuncts(const std::vector<size_t>& order) {
+  CheckPermutation(order, num_conjuncts(), "Formula::ReorderConjuncts()");
+  if (literals_) {
+    literals_->Reorder(order);
+    return;
+  }
+
+  std::vector<size_t> idx_conjuncts(conjuncts_.size());
+  for (size_t i = 0; i < conjuncts_.size(); i++) {
+    idx_conjuncts[conjuncts_[i].idx_source] = i;
+  }
+  std::vector<Conjunct> conjuncts;
+  conjuncts.reserve(conjuncts_.size());
+  for (const size_t idx_source : order) {
+    conjuncts.push_back(std::move(conjuncts_[idx_conjuncts[idx_source]]));
+  }
+  conjuncts_ = std::move(conjuncts);
+}
+
+void Formula::ReorderConjunctsByFailureRate() {
+  if (!profile_) {
+    throw std::runtime_error(
+        "Formula::ReorderConjunctsByFailureRate(): Profiling is not enabled.");
+  }
+  const std::vector<ConjunctStatistics> stats = conjunct_statistics();
+  auto FailureRate = [&stats](size_t idx) {
+    return stats[idx].num_evaluated == 0
+               ? -1.
+               : static_cast<double>(stats[idx].num_failed) /
+                     static_cast<double>(stats[idx].num_evaluated);
+  };
+
+  std::vector<size_t> order = conjunct_order();
+  std::stable_sort(order.begin(), order.end(),
+                   [&FailureRate](size_t lhs, size_t rhs) {
+                     return FailureRate(lhs) > FailureRate(rhs);
+                   });
+  ReorderConjuncts(order);
+}
+
+void Formula::set_profiling(bool profiling) {
+  profile_ = profiling ? std::make_shared<Profile>(num_conjuncts()) : nullptr;
+}
+
+std::vector<Formula::ConjunctStatistics> Formula::conjunct_statistics() const {
+  std::vector<ConjunctStatistics> stats(num_conjuncts());
+  if (!profile_) return stats;
+  for (size_t i = 0; i < stats.size(); i++) {
+    stats[i].num_evaluated = profile_->num_evaluated[i].load();
+    stats[i].num_failed = profile_->num_failed[i].load();
+  }
+  return stats;
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "Formula.ReorderConjuncts") {
+  Formula goal = pddl.goal();
+  goal.set_profiling(true);
+  REQUIRE(goal(pddl.initial_state()) == false);
+
+  // Only the third conjunct (on box shelf) fails in the initial state.
+  const std::vector<Formula::ConjunctStatistics> stats =
+      goal.conjunct_statistics();
+  REQUIRE(stats[2].num_evaluated == 1);
+  REQUIRE(stats[2].num_failed == 1);
+
+  goal.ReorderConjunctsByFailureRate();
+  REQUIRE((goal.conjunct_order() == std::vector<size_t>{2, 0, 1}));
+  REQUIRE(goal(pddl.initial_state()) == false);
+  REQUIRE(goal.conjunct_statistics()[2].num_evaluated == 2);
+  REQUIRE(goal.conjunct_statistics()[0].num_evaluated == 1);
+}
+
 std::optional<bool> Formula::operator()(
     const PartialState& state, const std::vector<Object>& arguments) const {
   try {
@@ -379,7 +743,7 @@ ostream& operator<<(ostream& os, const Formula& F) {
 ApplicationFunction Formula::CreateApplicationFunction(
     const std::vector<Object>& action_params,
     const std::vector<Object>& prop_params) {
-  auto prop_args = std::make_shared<std::vector<Object>>(prop_params);
+  ThreadLocalBuffer<std::vector<Object>> prop_args(prop_params);
 
   // List of (prop parameter index, action parameter index) pairs.
   std::vector<std::pair<size_t, size_t>> idx_params;
@@ -391,12 +755,12 @@ ApplicationFunction Formula::CreateApplicationFunction(
     }
   }
 
-  // TODO(tmigimatsu): shared_ptr makes this not thread-safe.
-  return [ptr_prop_args = std::move(prop_args),
+  // The buffer is thread-local so that formulas can be evaluated concurrently.
+  return [buffer = std::move(prop_args),
           idx_params =
               std::move(idx_params)](const std::vector<Object>& action_args)
              -> const std::vector<Object>& {
-    std::vector<Object>& prop_args = *ptr_prop_args;
+    std::vector<Object>& prop_args = buffer.get();
     for (const std::pair<size_t, size_t>& idx_prop_action : idx_params) {
       const size_t idx_prop = idx_prop_action.first;
       const size_t idx_action = idx_prop_action.second;
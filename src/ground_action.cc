@@ -0,0 +1,556 @@
+/**
+ * ground_action.cc
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#include "symbolic/ground_action.h"
+
+#include <VAL/ptree.h>
+
+#include <algorithm>  // std::any_of, std::find_if, std::set_intersection,
+                      // std::sort, std::stable_sort, std::unique
+#include <exception>  // std::out_of_range
+#include <iterator>   // std::back_inserter
+#include <optional>   // std::optional
+#include <utility>    // std::move, std::pair
+
+#include "symbolic/normal_form.h"
+#include "symbolic/pddl.h"
+#include "utils/doctest.h"
+
+namespace {
+
+using ::symbolic::Action;
+using ::symbolic::DisjunctiveFormula;
+using ::symbolic::GroundConditionalEffect;
+using ::symbolic::LiteralConjunction;
+using ::symbolic::Object;
+using ::symbolic::ParameterGenerator;
+using ::symbolic::Pddl;
+using ::symbolic::Proposition;
+using ::symbolic::StateIndex;
+
+/**
+ * Conjunction of positive and negative proposition indices.
+ */
+struct Literals {
+  std::vector<size_t> pos;
+  std::vector<size_t> neg;
+
+  bool empty() const { return pos.empty() && neg.empty(); }
+};
+
+/**
+ * Unconditional and conditional effects of a ground action.
+ *
+ * Unconditional effects are kept as writes in the order they are applied by
+ * the lifted action, where true adds and false deletes the proposition.
+ */
+struct Effects {
+  std::vector<std::pair<size_t, bool>> writes;
+  std::vector<GroundConditionalEffect> conditional;
+};
+
+void SortUnique(std::vector<size_t>* vals) {
+  std::sort(vals->begin(), vals->end());
+  vals->erase(std::unique(vals->begin(), vals->end()), vals->end());
+}
+
+/**
+ * Returns whether the sorted vectors have an element in common.
+ */
+bool Intersects(const std::vector<size_t>& lhs,
+                const std::vector<size_t>& rhs) {
+  std::vector<size_t> overlap;
+  std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                        std::back_inserter(overlap));
+  return !overlap.empty();
+}
+
+/**
+ * Maps the action arguments to the proposition arguments.
+ */
+std::vector<Object> ApplyArguments(const std::vector<Object>& parameters,
+                                   const std::vector<Object>& prop_params,
+                                   const std::vector<Object>& arguments) {
+  // Same parameter mapping as Formula::CreateApplicationFunction().
+  std::vector<Object> prop_args = prop_params;
+  for (size_t i = 0; i < prop_params.size(); i++) {
+    for (size_t j = 0; j < parameters.size(); j++) {
+      if (prop_params[i] == parameters[j]) prop_args[i] = arguments[j];
+    }
+  }
+  return prop_args;
+}
+
+std::optional<size_t> FindPropositionIndex(const StateIndex& state_index,
+                                           const Proposition& prop) {
+  try {
+    return state_index.GetPropositionIndex(prop);
+  } catch (const std::out_of_range& e) {
+    return {};
+  }
+}
+
+/**
+ * Adds the literal to the conjunction. Equality, type, and static literals are
+ * evaluated directly.
+ *
+ * @returns False if the literal is always false.
+ */
+bool AddLiteral(const Pddl& pddl, const Proposition& prop, bool is_pos,
+                Literals* literals) {
+  if (prop.name() == "=") {
+    return (prop.arguments()[0] == prop.arguments()[1]) == is_pos;
+  }
+  if (pddl.object_map().find(prop.name()) != pddl.object_map().end()) {
+    return prop.arguments()[0].type().IsSubtype(prop.name()) == is_pos;
+  }
+  if (pddl.IsStatic(prop.name())) {
+    return pddl.static_state().contains(prop) == is_pos;
+  }
+
+  // Propositions outside of the state index can never be true.
+  const std::optional<size_t> idx_prop =
+      FindPropositionIndex(pddl.state_index(), prop);
+  if (!idx_prop.has_value()) return !is_pos;
+
+  (is_pos ? literals->pos : literals->neg).push_back(*idx_prop);
+  return true;
+}
+
+/**
+ * Sorts the literals.
+ *
+ * @returns False if the conjunction contains a proposition and its negation.
+ */
+bool Normalize(Literals* literals) {
+  SortUnique(&literals->pos);
+  SortUnique(&literals->neg);
+  return !Intersects(literals->pos, literals->neg);
+}
+
+/**
+ * Converts the dnf into conjunctions of proposition indices, starting from the
+ * given conjunction.
+ */
+std::vector<Literals> GroundDnf(const Pddl& pddl, const DisjunctiveFormula& dnf,
+                                const Literals& literals) {
+  // Empty dnf is always true.
+  if (dnf.empty()) return {literals};
+
+  std::vector<Literals> conjunctions;
+  conjunctions.reserve(dnf.conjunctions.size());
+  for (const DisjunctiveFormula::Conjunction& conj : dnf.conjunctions) {
+    Literals conj_literals = literals;
+    bool is_valid = true;
+    for (const Proposition& prop : conj.pos()) {
+      is_valid = AddLiteral(pddl, prop, true, &conj_literals);
+      if (!is_valid) break;
+    }
+    if (!is_valid) continue;
+    for (const Proposition& prop : conj.neg()) {
+      is_valid = AddLiteral(pddl, prop, false, &conj_literals);
+      if (!is_valid) break;
+    }
+    if (!is_valid || !Normalize(&conj_literals)) continue;
+
+    conjunctions.push_back(std::move(conj_literals));
+  }
+  return conjunctions;
+}
+
+/**
+ * Grounds the preconditions into a disjunction of literal conjunctions.
+ */
+std::vector<Literals> GroundPreconditions(
+    const Pddl& pddl, const Action& action,
+    const std::vector<Object>& arguments) {
+  // Pure conjunctions can be read off the compiled literals directly.
+  const LiteralConjunction* literals =
+      action.preconditions().literal_conjunction();
+  if (literals != nullptr) {
+    Literals conj;
+    for (const LiteralConjunction::Literal& literal : literals->literals()) {
+      const Proposition prop(*literal.name_predicate,
+                             literals->Arguments(literal, arguments));
+      if (!AddLiteral(pddl, prop, literal.is_pos, &conj)) return {};
+    }
+    if (!Normalize(&conj)) return {};
+    return {std::move(conj)};
+  }
+
+  const std::optional<DisjunctiveFormula> dnf = DisjunctiveFormula::Create(
+      pddl, action.preconditions(), action.parameters(), arguments);
+  if (!dnf.has_value()) return {};
+  return GroundDnf(pddl, *dnf, Literals());
+}
+
+void GroundEffects(const Pddl& pddl, const VAL::effect_lists* effects,
+                   const std::vector<Object>& parameters,
+                   const std::vector<Object>& arguments,
+                   const Literals& condition, Effects* ground_effects) {
+  // Forall effects
+  for (const VAL::forall_effect* effect : effects->forall_effects) {
+    std::vector<Object> forall_params = parameters;
+    const std::vector<Object> types =
+        Object::CreateList(pddl, effect->getVarsList());
+    forall_params.insert(forall_params.end(), types.begin(), types.end());
+
+    ParameterGenerator gen(pddl, types);
+    for (const std::vector<Object>& forall_objs : gen) {
+      std::vector<Object> forall_args = arguments;
+      forall_args.insert(forall_args.end(), forall_objs.begin(),
+                         forall_objs.end());
+      GroundEffects(pddl, effect->getEffects(), forall_params, forall_args,
+                    condition, ground_effects);
+    }
+  }
+
+  // Simple effects
+  std::vector<size_t> add;
+  std::vector<size_t> del;
+  const auto GroundSimpleEffect = [&](const VAL::simple_effect* effect,
+                                      std::vector<size_t>* idx_props) {
+    const Proposition prop(
+        effect->prop->head->getName(),
+        ApplyArguments(parameters, Object::CreateList(pddl, effect->prop->args),
+                       arguments));
+    const std::optional<size_t> idx_prop =
+        FindPropositionIndex(pddl.state_index(), prop);
+    if (idx_prop.has_value()) idx_props->push_back(*idx_prop);
+  };
+  for (const VAL::simple_effect* effect : effects->add_effects) {
+    GroundSimpleEffect(effect, &add);
+  }
+  for (const VAL::simple_effect* effect : effects->del_effects) {
+    GroundSimpleEffect(effect, &del);
+  }
+
+  if (condition.empty()) {
+    for (const size_t idx_prop : add) {
+      ground_effects->writes.emplace_back(idx_prop, true);
+    }
+    for (const size_t idx_prop : del) {
+      ground_effects->writes.emplace_back(idx_prop, false);
+    }
+  } else if (!add.empty() || !del.empty()) {
+    SortUnique(&add);
+    SortUnique(&del);
+    ground_effects->conditional.push_back(
+        {condition.pos, condition.neg, std::move(add), std::move(del)});
+  }
+
+  // Cond effects
+  for (const VAL::cond_effect* effect : effects->cond_effects) {
+    const std::optional<DisjunctiveFormula> dnf = DisjunctiveFormula::Create(
+        pddl, effect->getCondition(), parameters, arguments);
+    if (!dnf.has_value()) continue;  // Condition always false
+
+    // Create one conditional effect per disjunct of the condition.
+    for (const Literals& conj : GroundDnf(pddl, *dnf, condition)) {
+      GroundEffects(pddl, effect->getEffects(), parameters, arguments, conj,
+                    ground_effects);
+    }
+  }
+}
+
+/**
+ * Reduces the unconditional writes to disjoint add and delete effects, where
+ * the last write to each proposition wins.
+ */
+void ReduceWrites(std::vector<std::pair<size_t, bool>> writes,
+                  std::vector<size_t>* add, std::vector<size_t>* del) {
+  std::stable_sort(
+      writes.begin(), writes.end(),
+      [](const std::pair<size_t, bool>& lhs,
+         const std::pair<size_t, bool>& rhs) { return lhs.first < rhs.first; });
+  for (size_t i = 0; i < writes.size(); i++) {
+    if (i + 1 < writes.size() && writes[i + 1].first == writes[i].first) {
+      continue;
+    }
+    (writes[i].second ? add : del)->push_back(writes[i].first);
+  }
+}
+
+/**
+ * Returns whether the result of the effects depends on the order in which they
+ * are applied, which is the case when a conditional effect may write a
+ * proposition that another effect writes with the opposite value, or that a
+ * condition reads.
+ */
+bool IsOrderDependent(const std::vector<size_t>& add,
+                      const std::vector<size_t>& del,
+                      const std::vector<GroundConditionalEffect>& conditional) {
+  if (conditional.empty()) return false;
+
+  std::vector<size_t> written_add = add;
+  std::vector<size_t> written_del = del;
+  std::vector<size_t> read;
+  for (const GroundConditionalEffect& effect : conditional) {
+    written_add.insert(written_add.end(), effect.add_effects.begin(),
+                       effect.add_effects.end());
+    written_del.insert(written_del.end(), effect.del_effects.begin(),
+                       effect.del_effects.end());
+    read.insert(read.end(), effect.pre_pos.begin(), effect.pre_pos.end());
+    read.insert(read.end(), effect.pre_neg.begin(), effect.pre_neg.end());
+  }
+  SortUnique(&written_add);
+  SortUnique(&written_del);
+  SortUnique(&read);
+  return Intersects(written_add, written_del) ||
+         Intersects(read, written_add) || Intersects(read, written_del);
+}
+
+}  // namespace
+
+namespace symbolic {
+
+std::vector<GroundAction> GroundAction::Ground(const Pddl& pddl) {
+  std::vector<GroundAction> ground_actions;
+
+  const auto GroundArguments = [&pddl, &ground_actions](
+                                   const Action& action,
+                                   const std::vector<Object>& arguments) {
+    const std::vector<Literals> preconditions =
+        GroundPreconditions(pddl, action, arguments);
+    if (preconditions.empty()) return;
+
+    Effects effects;
+    GroundEffects(pddl, action.postconditions(), action.parameters(),
+                  arguments, Literals(), &effects);
+    std::vector<size_t> add;
+    std::vector<size_t> del;
+    ReduceWrites(std::move(effects.writes), &add, &del);
+    const bool is_order_dependent =
+        IsOrderDependent(add, del, effects.conditional);
+
+    for (const Literals& pre : preconditions) {
+      GroundAction ground_action(ground_actions.size(), action, arguments);
+      ground_action.state_index_ = &pddl.state_index();
+      ground_action.pre_pos_ = pre.pos;
+      ground_action.pre_neg_ = pre.neg;
+      ground_action.add_effects_ = add;
+      ground_action.del_effects_ = del;
+      ground_action.conditional_effects_ = effects.conditional;
+      ground_action.is_order_dependent_ = is_order_dependent;
+      ground_actions.push_back(std::move(ground_action));
+    }
+  };
+
+  for (const Action& action : pddl.actions()) {
+    if (action.parameters().empty()) {
+      GroundArguments(action, {});
+      continue;
+    }
+    // Actions can only be applied with the static facts of the initial state.
+    const ParameterGenerator param_gen =
+        action.CreateStaticParameterGenerator();
+    for (const std::vector<Object>& arguments : param_gen) {
+      GroundArguments(action, arguments);
+    }
+  }
+  return ground_actions;
+}
+
+std::vector<GroundAction> GroundAction::Select(
+    const std::vector<GroundAction>& actions, const std::vector<size_t>& ids) {
+  std::vector<GroundAction> selected;
+  selected.reserve(ids.size());
+  for (const size_t id : ids) {
+    selected.push_back(actions.at(id));
+    selected.back().id_ = selected.size() - 1;
+  }
+  return selected;
+}
+
+bool GroundConjunction::IsSatisfied(
+    const StateIndex::IndexedState& state) const {
+  for (const size_t idx_prop : pos) {
+    if (!state[idx_prop]) return false;
+  }
+  for (const size_t idx_prop : neg) {
+    if (state[idx_prop]) return false;
+  }
+  return true;
+}
+
+std::vector<GroundConjunction> GroundAction::GroundGoal(const Pddl& pddl) {
+  const std::optional<DisjunctiveFormula> dnf =
+      DisjunctiveFormula::Create(pddl, pddl.goal(), {}, {});
+  if (!dnf.has_value()) return {};
+
+  std::vector<GroundConjunction> goal;
+  for (Literals& conj : GroundDnf(pddl, *dnf, Literals())) {
+    goal.push_back({std::move(conj.pos), std::move(conj.neg)});
+  }
+  return goal;
+}
+
+bool GroundAction::IsGoal(const std::vector<GroundConjunction>& goal,
+                          const StateIndex::IndexedState& state) {
+  return std::any_of(goal.begin(), goal.end(),
+                     [&state](const GroundConjunction& conj) {
+                       return conj.IsSatisfied(state);
+                     });
+}
+
+StateIndex::IndexedState GroundAction::GetRoot(const Pddl& pddl,
+                                               const State& state) {
+  return pddl.state_index().GetIndexedState(
+      pddl.DerivedState(pddl.ConsistentState(state)));
+}
+
+bool GroundAction::IsDerivationFree(const Pddl& pddl) {
+  return pddl.axioms().empty() && pddl.derived_predicates().empty();
+}
+
+bool GroundAction::IsApplicable(const StateIndex::IndexedState& state) const {
+  for (const size_t idx_prop : pre_pos_) {
+    if (!state[idx_prop]) return false;
+  }
+  for (const size_t idx_prop : pre_neg_) {
+    if (state[idx_prop]) return false;
+  }
+  return true;
+}
+
+void GroundAction::Apply(StateIndex::IndexedState* state) const {
+  if (is_order_dependent_) {
+    State lifted_state = state_index_->GetState(*state);
+    action_->Apply(arguments_, &lifted_state);
+    *state = state_index_->GetIndexedState(lifted_state);
+    return;
+  }
+
+  // Evaluate conditions before modifying the state. Since the effects are
+  // order independent, this gives the same result as the lifted action.
+  std::vector<const GroundConditionalEffect*> effects;
+  for (const GroundConditionalEffect& effect : conditional_effects_) {
+    bool is_active = true;
+    for (const size_t idx_prop : effect.pre_pos) {
+      is_active &= (*state)[idx_prop];
+    }
+    for (const size_t idx_prop : effect.pre_neg) {
+      is_active &= !(*state)[idx_prop];
+    }
+    if (is_active) effects.push_back(&effect);
+  }
+
+  for (const size_t idx_prop : del_effects_) (*state)[idx_prop] = false;
+  for (const GroundConditionalEffect* effect : effects) {
+    for (const size_t idx_prop : effect->del_effects) {
+      (*state)[idx_prop] = false;
+    }
+  }
+  for (const size_t idx_prop : add_effects_) (*state)[idx_prop] = true;
+  for (const GroundConditionalEffect* effect : effects) {
+    for (const size_t idx_prop : effect->add_effects) {
+      (*state)[idx_prop] = true;
+    }
+  }
+}
+
+void GroundAction::Apply(const Pddl& pddl,
+                         StateIndex::IndexedState* state) const {
+  if (IsDerivationFree(pddl)) {
+    Apply(state);
+    return;
+  }
+  const StateIndex& state_index = pddl.state_index();
+  State next_state = state_index.GetState(*state);
+  pddl.ApplyAction(*action_, arguments_, &next_state);
+  *state = state_index.GetIndexedState(next_state);
+}
+
+std::ostream& operator<<(std::ostream& os, const GroundAction& action) {
+  os << action.to_string();
+  return os;
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "GroundAction.Ground") {
+  const std::vector<GroundAction> ground_actions = GroundAction::Ground(pddl);
+  REQUIRE(!ground_actions.empty());
+
+  const StateIndex& state_index = pddl.state_index();
+  const StateIndex::IndexedState s0 =
+      state_index.GetIndexedState(pddl.initial_state());
+  size_t num_applicable = 0;
+  for (const GroundAction& action : ground_actions) {
+    // Ground preconditions agree with the lifted ones.
+    REQUIRE(action.IsApplicable(s0) ==
+            action.action().IsValid(pddl.initial_state(), action.arguments()));
+    if (!action.IsApplicable(s0)) continue;
+    num_applicable++;
+
+    // Ground effects agree with the lifted ones.
+    StateIndex::IndexedState s1 = s0;
+    action.Apply(&s1);
+    REQUIRE(state_index.GetState(s1) ==
+            pddl.NextState(pddl.initial_state(), action.to_string()));
+  }
+  REQUIRE(num_applicable == pddl.ListValidActions(pddl.initial_state()).size());
+}
+
+TEST_CASE_FIXTURE(testing::EffectsFixture, "GroundAction.Apply") {
+  const std::vector<GroundAction> ground_actions = GroundAction::Ground(pddl);
+  const StateIndex& state_index = pddl.state_index();
+  const StateIndex::IndexedState s0 =
+      state_index.GetIndexedState(pddl.initial_state());
+  std::vector<std::string> action_calls;
+  for (const GroundAction& action : ground_actions) {
+    if (!action.IsApplicable(s0)) continue;
+    action_calls.push_back(action.to_string());
+
+    // The last of the coinciding add and delete effects wins.
+    StateIndex::IndexedState s1 = s0;
+    action.Apply(&s1);
+    REQUIRE(state_index.GetState(s1) ==
+            pddl.NextState(pddl.initial_state(), action.to_string()));
+  }
+  REQUIRE((action_calls == std::vector<std::string>{
+                               "move(c1, c1)", "move(c1, c2)", "toggle(c1)"}));
+
+  // The add and delete effects of move(c1, c1) reduce to a delete, and the
+  // conditional effects of toggle read each other's writes.
+  const GroundAction& move = ground_actions.front();
+  REQUIRE(move.add_effects().size() == 1);
+  REQUIRE(move.del_effects().size() == 1);
+  REQUIRE(!move.is_order_dependent());
+  REQUIRE(ground_actions.back().is_order_dependent());
+}
+
+TEST_CASE_FIXTURE(testing::DerivedFixture, "GroundAction.Apply.Derived") {
+  pddl.Ground();
+  const StateIndex& state_index = pddl.state_index();
+  const std::vector<GroundAction>& ground_actions = pddl.ground_actions();
+  const std::vector<GroundConjunction> goal = GroundAction::GroundGoal(pddl);
+  REQUIRE(!GroundAction::IsDerivationFree(pddl));
+  const std::vector<std::string> plan = {"unstack(a, b)", "putdown(a)",
+                                         "unstack(b, c)", "stack(b, a)",
+                                         "pick(c)",       "stack(c, b)"};
+
+  // The successors update the derived predicates of the root.
+  State state = pddl.DerivedState(pddl.ConsistentState(pddl.initial_state()));
+  StateIndex::IndexedState indexed =
+      GroundAction::GetRoot(pddl, pddl.initial_state());
+  REQUIRE(state_index.GetState(indexed) == state);
+  for (const std::string& action_call : plan) {
+    REQUIRE(!GroundAction::IsGoal(goal, indexed));
+    const auto it = std::find_if(ground_actions.begin(), ground_actions.end(),
+                                 [&action_call](const GroundAction& action) {
+                                   return action.to_string() == action_call;
+                                 });
+    REQUIRE(it != ground_actions.end());
+    it->Apply(pddl, &indexed);
+    state = pddl.NextState(state, action_call);
+    REQUIRE(state_index.GetState(indexed) == state);
+  }
+  REQUIRE(GroundAction::IsGoal(goal, indexed));
+}
+
+}  // namespace symbolic
@@ -18,6 +18,7 @@
 
 #include "symbolic/pddl.h"
 #include "symbolic/utils/combination_generator.h"
+#include "utils/doctest.h"
 
 namespace {
 
@@ -189,8 +190,14 @@ std::optional<DisjunctiveFormula> Simplify(const Pddl& pddl,
 std::optional<DisjunctiveFormula> Disjoin(
     const Pddl& pddl, std::vector<DisjunctiveFormula>&& dnfs,
     bool apply_axioms) {
+  // Empty disjunction is always false.
+  if (dnfs.empty()) return {};
+
   DisjunctiveFormula disj;
   for (DisjunctiveFormula& dnf : dnfs) {
+    // Empty dnf is always true, so the disjunction is also true.
+    if (dnf.empty()) return DisjunctiveFormula();
+
     disj.conjunctions.insert(disj.conjunctions.end(),
                              std::make_move_iterator(dnf.conjunctions.begin()),
                              std::make_move_iterator(dnf.conjunctions.end()));
@@ -592,4 +599,24 @@ std::ostream& operator<<(std::ostream& os, const ConjunctiveFormula& cnf) {
   return os;
 }
 
+TEST_CASE_FIXTURE(testing::Fixture, "Disjoin") {
+  const DisjunctiveFormula on_box = {
+      PartialState(pddl, {"on(box, table)"}, {})};
+  const DisjunctiveFormula on_hook = {
+      PartialState(pddl, {"on(hook, table)"}, {})};
+
+  // An empty disjunction is false.
+  REQUIRE(!Disjoin(pddl, {}, false).has_value());
+
+  // A true disjunct makes the whole disjunction true.
+  std::optional<DisjunctiveFormula> disj =
+      Disjoin(pddl, {DisjunctiveFormula(), on_box}, false);
+  REQUIRE(disj.has_value());
+  REQUIRE(disj->empty());
+
+  disj = Disjoin(pddl, {on_box, on_hook}, false);
+  REQUIRE(disj.has_value());
+  REQUIRE(disj->conjunctions.size() == 2);
+}
+
 }  // namespace symbolic
@@ -19,6 +19,7 @@
 
 namespace {
 
+using ::symbolic::Object;
 using ::symbolic::Pddl;
 
 const VAL::pddl_type* GetTypeSymbol(const VAL::pddl_type_list* types,
@@ -35,8 +36,12 @@ const VAL::pddl_type* GetTypeSymbol(const VAL::pddl_type_list* types,
   return nullptr;
 }
 
-const VAL::const_symbol* GetSymbol(const Pddl& pddl,
-                                   const std::string& name_object) {
+const VAL::pddl_typed_symbol* GetSymbol(const Pddl& pddl,
+                                        const std::string& name_object) {
+  const Object* object = pddl.FindObject(name_object);
+  if (object != nullptr) return object->symbol();
+
+  // Fall back to a linear search while the pddl is being constructed.
   if (pddl.symbol()->the_domain->constants != nullptr) {
     for (const VAL::const_symbol* obj : *pddl.symbol()->the_domain->constants) {
       if (obj == nullptr) continue;
@@ -132,7 +137,12 @@ std::vector<Object> Object::ParseArguments(const Pddl& pddl,
   std::vector<Object> args;
   args.reserve(name_args.size());
   for (const std::string& name_arg : name_args) {
-    args.emplace_back(pddl, name_arg);
+    const Object* object = pddl.FindObject(name_arg);
+    if (object != nullptr) {
+      args.push_back(*object);
+    } else {
+      args.emplace_back(pddl, name_arg);
+    }
   }
   return args;
 }
@@ -13,10 +13,16 @@
 #include <VAL/ptree.h>
 #include <VAL/typecheck.h>
 
-#include <fstream>  // std::ifstream
-#include <sstream>  // std::stringstream
-#include <string>   // std::string
-#include <utility>  // std::move
+#include <algorithm>      // std::find_if, std::max, std::min
+#include <fstream>        // std::ifstream, std::ofstream
+#include <functional>     // std::function
+#include <iterator>       // std::make_move_iterator
+#include <set>            // std::set
+#include <sstream>        // std::stringstream
+#include <string>         // std::string
+#include <unordered_map>  // std::unordered_map
+#include <unordered_set>  // std::unordered_set
+#include <utility>        // std::move
 
 #include "symbolic/utils/parameter_generator.h"
 #include "utils/doctest.h"
@@ -101,15 +107,23 @@ std::unique_ptr<VAL::analysis> ParsePddl(const std::string& filename_domain,
   return analysis;
 }
 
+using ::symbolic::AddEffectPredicates;
 using ::symbolic::Action;
 using ::symbolic::Axiom;
 using ::symbolic::DerivedPredicate;
+using ::symbolic::GroundAction;
+using ::symbolic::LoggedState;
 using ::symbolic::Object;
+using ::symbolic::ParameterGenerator;
 using ::symbolic::PartialState;
 using ::symbolic::Pddl;
 using ::symbolic::Predicate;
 using ::symbolic::Proposition;
+using ::symbolic::PropositionBase;
+using ::symbolic::SignedProposition;
 using ::symbolic::State;
+using ::symbolic::ThreadPool;
+using ::symbolic::UndoLog;
 
 State ParseState(const Pddl& pddl, const std::set<std::string>& str_state) {
   State state;
@@ -154,6 +168,16 @@ std::unordered_map<std::string, std::vector<Object>> CreateObjectTypeMap(
   return object_map;
 }
 
+std::unordered_map<std::string, Object> CreateObjectNameMap(
+    const std::vector<Object>& objects) {
+  std::unordered_map<std::string, Object> object_names;
+  object_names.reserve(objects.size());
+  for (const Object& object : objects) {
+    object_names.emplace(object.name(), object);
+  }
+  return object_names;
+}
+
 std::vector<Action> GetActions(const Pddl& pddl, const VAL::domain& domain) {
   std::vector<Action> actions;
   for (const VAL::operator_* op : *domain.ops) {
@@ -164,6 +188,16 @@ std::vector<Action> GetActions(const Pddl& pddl, const VAL::domain& domain) {
   return actions;
 }
 
+std::unordered_map<std::string, size_t> CreateActionIndexMap(
+    const std::vector<Action>& actions) {
+  std::unordered_map<std::string, size_t> idx_actions;
+  idx_actions.reserve(actions.size());
+  for (size_t i = 0; i < actions.size(); i++) {
+    idx_actions.emplace(actions[i].name(), i);
+  }
+  return idx_actions;
+}
+
 std::vector<Predicate> GetPredicates(const Pddl& pddl,
                                      const VAL::domain& domain) {
   std::vector<Predicate> predicates;
@@ -173,6 +207,89 @@ std::vector<Predicate> GetPredicates(const Pddl& pddl,
   return predicates;
 }
 
+std::set<std::string> GetStaticPredicates(const Pddl& pddl,
+                                          const VAL::domain& domain) {
+  // Collect the predicates modified by actions and axioms.
+  std::set<std::string> fluents;
+  for (const VAL::operator_* op : *domain.ops) {
+    AddEffectPredicates(op->effects, &fluents);
+  }
+  for (const DerivedPredicate& pred : pddl.derived_predicates()) {
+    fluents.insert(pred.name());
+  }
+
+  // Equality and type predicates are evaluated from the objects.
+  fluents.insert("=");
+  for (const auto& key_val : pddl.object_map()) fluents.insert(key_val.first);
+
+  std::set<std::string> static_predicates;
+  for (const Predicate& pred : pddl.predicates()) {
+    if (fluents.find(pred.name()) != fluents.end()) continue;
+    static_predicates.insert(pred.name());
+  }
+  return static_predicates;
+}
+
+State GetStaticState(const Pddl& pddl, const State& state) {
+  State static_state;
+  for (const Proposition& prop : state) {
+    if (pddl.IsStatic(prop.name())) static_state.insert(prop);
+  }
+  return static_state;
+}
+
+/**
+ * Applies the axioms until the state is closed under them.
+ *
+ * Axioms with negative contexts are applied in full once, since their contexts
+ * can't be enumerated from the state. Axioms with positive contexts are seeded
+ * with the propositions of the state. Afterwards, only the axioms whose context
+ * matches a changed proposition are applied.
+ *
+ * @param pddl Pddl object.
+ * @param state State to modify.
+ * @param stop_on_change Whether to return as soon as the state changes.
+ * @returns Whether the state changed.
+ */
+bool CloseAxioms(const Pddl& pddl, State* state, bool stop_on_change) {
+  if (pddl.axioms().empty()) return false;
+
+  UndoLog log;
+  log.Checkpoint();
+  LoggedState logged_state(state, &log);
+  const auto IsChanged = [&log]() { return !log.entries().empty(); };
+
+  for (const std::shared_ptr<Axiom>& axiom : pddl.axioms()) {
+    if (axiom->context().is_pos()) continue;
+    axiom->Apply(&logged_state);
+    if (stop_on_change && IsChanged()) return true;
+  }
+
+  const auto ApplyContext = [&pddl, &logged_state](const PropositionBase& prop,
+                                                   bool is_pos) {
+    const auto it = pddl.axiom_map().find(SignedProposition::Sign(is_pos) +
+                                          prop.name());
+    if (it == pddl.axiom_map().end()) return;
+    for (const std::weak_ptr<Axiom>& axiom : it->second) {
+      axiom.lock()->ApplyContext(prop, &logged_state);
+    }
+  };
+
+  // Seed with the propositions of the state.
+  const std::vector<Proposition> props(state->begin(), state->end());
+  for (const Proposition& prop : props) {
+    ApplyContext(prop, true);
+    if (stop_on_change && IsChanged()) return true;
+  }
+
+  // Process the changed propositions until the state stops changing.
+  for (size_t i = 0; i < log.entries().size(); i++) {
+    const UndoLog::Entry entry = log.entries()[i];
+    ApplyContext(entry.prop, entry.is_added);
+  }
+  return IsChanged();
+}
+
 std::vector<std::shared_ptr<Axiom>> GetAxioms(const Pddl& pddl,
                                               const VAL::domain& domain) {
   std::vector<std::shared_ptr<Axiom>> axioms;
@@ -228,21 +345,118 @@ State GetInitialState(const VAL::domain& domain, const VAL::problem& problem) {
   return initial_state;
 }
 
-State Apply(const State& state, const Action& action,
-            const std::vector<Object>& arguments,
-            const std::vector<DerivedPredicate>& predicates) {
+State Apply(const Pddl& pddl, const State& state, const Action& action,
+            const std::vector<Object>& arguments) {
   State next_state = action.Apply(state, arguments);
-  DerivedPredicate::Apply(predicates, &next_state);
+  pddl.ApplyDerivedPredicates(&next_state);
   return next_state;
 }
 
-bool Apply(const Action& action, const std::vector<Object>& arguments,
-           const std::vector<DerivedPredicate>& predicates, State* state) {
+bool Apply(const Pddl& pddl, const Action& action,
+           const std::vector<Object>& arguments, State* state) {
   bool is_changed = action.Apply(arguments, state);
-  is_changed |= DerivedPredicate::Apply(predicates, state);
+  is_changed |= pddl.ApplyDerivedPredicates(state);
   return is_changed;
 }
 
+/**
+ * Range of parameter combinations of one action, which is evaluated as one
+ * task when listing valid actions in parallel.
+ */
+struct ParameterRange {
+  size_t idx_action;
+  size_t idx_begin;
+  size_t idx_end;
+};
+
+/**
+ * Lists the outputs of the valid parameter combinations of the actions in
+ * parallel, in the order of the actions and their parameter generators.
+ */
+template <typename T, typename OutputFunction>
+std::vector<T> ListValid(const State& state,
+                         const std::vector<const Action*>& actions,
+                         const std::vector<ParameterGenerator>& param_gens,
+                         ThreadPool* pool, const OutputFunction& Output) {
+  // Create a few ranges per thread so that threads that get cheap ranges can
+  // pick up more work.
+  size_t num_combinations = 0;
+  for (const ParameterGenerator& param_gen : param_gens) {
+    num_combinations += param_gen.size();
+  }
+  const size_t num_ranges = 4 * pool->num_threads();
+  const size_t size_range =
+      std::max<size_t>(1, (num_combinations + num_ranges - 1) / num_ranges);
+
+  std::vector<ParameterRange> ranges;
+  for (size_t i = 0; i < param_gens.size(); i++) {
+    const size_t size = param_gens[i].size();
+    for (size_t idx_begin = 0; idx_begin < size; idx_begin += size_range) {
+      ranges.push_back({i, idx_begin, std::min(idx_begin + size_range, size)});
+    }
+  }
+
+  // Each range writes to its own output.
+  std::vector<std::vector<T>> range_outputs(ranges.size());
+  pool->Run(ranges.size(), [&](size_t idx_range) {
+    const ParameterRange& range = ranges[idx_range];
+    const Action& action = *actions[range.idx_action];
+    const ParameterGenerator& param_gen = param_gens[range.idx_action];
+    std::vector<T>& outputs = range_outputs[idx_range];
+    auto it = param_gen.begin() + range.idx_begin;
+    for (size_t i = range.idx_begin; i < range.idx_end; i++, ++it) {
+      const std::vector<Object>& arguments = *it;
+      if (action.IsValid(state, arguments)) {
+        outputs.push_back(Output(action, arguments));
+      }
+    }
+  });
+
+  std::vector<T> outputs;
+  for (std::vector<T>& range_output : range_outputs) {
+    outputs.insert(outputs.end(), std::make_move_iterator(range_output.begin()),
+                   std::make_move_iterator(range_output.end()));
+  }
+  return outputs;
+}
+
+/**
+ * Checks the inputs of a batch of ground action applications.
+ */
+void CheckBatch(const Pddl& pddl, size_t num_states,
+                const std::vector<size_t>& actions,
+                const std::string& name_function) {
+  if (!pddl.is_grounded()) {
+    throw std::runtime_error(name_function +
+                             "(): Actions have not been grounded.");
+  }
+  if (actions.size() != num_states) {
+    throw std::invalid_argument(
+        name_function + "(): Received " + std::to_string(num_states) +
+        " states but " + std::to_string(actions.size()) + " actions.");
+  }
+  for (const size_t id : actions) {
+    if (id >= pddl.ground_actions().size()) {
+      throw std::out_of_range(name_function + "(): Invalid ground action id " +
+                              std::to_string(id) + ".");
+    }
+  }
+}
+
+/**
+ * Calls Task(i) for every i in [0, num_tasks) on the thread pool, with a few
+ * contiguous ranges of tasks per thread.
+ */
+void RunBatch(ThreadPool* pool, size_t num_tasks,
+              const std::function<void(size_t)>& Task) {
+  const size_t num_ranges = std::min(num_tasks, 4 * pool->num_threads());
+  pool->Run(num_ranges, [num_tasks, num_ranges, &Task](size_t idx_range) {
+    const size_t idx_begin = idx_range * num_tasks / num_ranges;
+    const size_t idx_end = (idx_range + 1) * num_tasks / num_ranges;
+    for (size_t i = idx_begin; i < idx_end; i++) Task(i);
+  });
+}
+
 }  // namespace
 
 namespace symbolic {
@@ -255,6 +469,7 @@ Pddl::Pddl(const std::string& domain_pddl, const std::string& problem_pddl,
       constants_(GetObjects(*analysis_->the_domain)),
       objects_(GetObjects(*analysis_->the_domain, analysis_->the_problem)),
       object_map_(CreateObjectTypeMap(objects_)),
+      object_names_(CreateObjectNameMap(objects_)),
       axioms_(GetAxioms(*this, *analysis_->the_domain)),
       predicates_(GetPredicates(*this, *analysis_->the_domain)),
       derived_predicates_(GetDerivedPredicates(*this, *analysis_->the_domain)),
@@ -271,8 +486,15 @@ Pddl::Pddl(const std::string& domain_pddl, const std::string& problem_pddl,
   // while handling axiom loops.
   UpdateAxioms(*this, &axioms_);
 
+  derived_program_ = DatalogProgram(*this, derived_predicates_);
+
+  static_predicates_ = GetStaticPredicates(*this, *analysis_->the_domain);
+  static_state_ = GetStaticState(*this, initial_state_);
+
   // Create actions after all axioms have settled.
   actions_ = GetActions(*this, *analysis_->the_domain);
+  idx_actions_ = CreateActionIndexMap(actions_);
+  relevance_index_ = RelevanceIndex(actions_);
 
   if (apply_axioms) {
     initial_state_ = ConsistentState(initial_state_);
@@ -284,6 +506,7 @@ Pddl::Pddl(const std::string& domain_pddl)
       domain_pddl_(domain_pddl),
       objects_(GetObjects(*analysis_->the_domain)),
       object_map_(CreateObjectTypeMap(objects_)),
+      object_names_(CreateObjectNameMap(objects_)),
       axioms_(GetAxioms(*this, *analysis_->the_domain)),
       predicates_(GetPredicates(*this, *analysis_->the_domain)),
       derived_predicates_(GetDerivedPredicates(*this, *analysis_->the_domain)),
@@ -297,8 +520,12 @@ Pddl::Pddl(const std::string& domain_pddl)
   // while handling axiom loops.
   UpdateAxioms(*this, &axioms_);
 
+  derived_program_ = DatalogProgram(*this, derived_predicates_);
+
   // Create actions after all axioms have settled.
   actions_ = GetActions(*this, *analysis_->the_domain);
+  idx_actions_ = CreateActionIndexMap(actions_);
+  relevance_index_ = RelevanceIndex(actions_);
 }
 
 bool Pddl::IsValid(bool verbose, std::ostream& os) const {
@@ -319,15 +546,70 @@ bool Pddl::IsValid(bool verbose, std::ostream& os) const {
 
 TEST_CASE_FIXTURE(testing::Fixture, "Pddl.IsValid") { REQUIRE(pddl.IsValid()); }
 
+TEST_CASE_FIXTURE(testing::Fixture, "Pddl.static_predicates") {
+  // throwable is a type, and all the other predicates appear in action effects.
+  REQUIRE(pddl.static_predicates().empty());
+  REQUIRE(pddl.static_state().empty());
+}
+
+TEST_CASE_FIXTURE(testing::EffectsFixture, "Pddl.static_state") {
+  REQUIRE((pddl.static_predicates() == std::set<std::string>{"connected"}));
+
+  // Replace connected(c2, c3) with connected(c3, c1) and start from c3.
+  State state = pddl.initial_state();
+  state.erase(Proposition(pddl, "connected(c2, c3)"));
+  state.erase(Proposition(pddl, "at(c1)"));
+  state.insert(Proposition(pddl, "connected(c3, c1)"));
+  state.insert(Proposition(pddl, "at(c3)"));
+  pddl.set_initial_state(State(state));
+  const State& static_state = pddl.static_state();
+  REQUIRE(static_state.contains(Proposition(pddl, "connected(c3, c1)")));
+  REQUIRE(!static_state.contains(Proposition(pddl, "connected(c2, c3)")));
+
+  // ?a is restricted to {c1, c3} and ?b to {c1, c2} only when grounding.
+  const Action& move = pddl.actions().front();
+  REQUIRE(move.parameter_generator().size() == 9);
+  REQUIRE(move.CreateStaticParameterGenerator().size() == 4);
+  const auto GroundMoves = [this, &move]() {
+    std::vector<std::string> moves;
+    for (const GroundAction& action : pddl.Ground()) {
+      if (&action.action() == &move) moves.push_back(action.to_string());
+    }
+    return moves;
+  };
+  REQUIRE((GroundMoves() ==
+           std::vector<std::string>{"move(c1, c1)", "move(c1, c2)",
+                                    "move(c3, c1)"}));
+  REQUIRE(move.parameter_generator().size() == 9);
+
+  // Lifted enumeration isn't affected by grounding.
+  const std::vector<std::string> valid_actions = pddl.ListValidActions(state);
+  REQUIRE(std::find(valid_actions.begin(), valid_actions.end(),
+                    "move(c3, c1)") != valid_actions.end());
+
+  // Changing the static propositions clears the ground actions.
+  state.erase(Proposition(pddl, "connected(c3, c1)"));
+  state.insert(Proposition(pddl, "connected(c3, c2)"));
+  pddl.set_initial_state(State(state));
+  REQUIRE(!pddl.is_grounded());
+  REQUIRE((GroundMoves() ==
+           std::vector<std::string>{"move(c1, c1)", "move(c1, c2)",
+                                    "move(c3, c2)"}));
+
+  // Changing only the fluents keeps them.
+  state.erase(Proposition(pddl, "at(c3)"));
+  state.insert(Proposition(pddl, "at(c1)"));
+  pddl.set_initial_state(State(state));
+  REQUIRE(pddl.is_grounded());
+}
+
 State Pddl::NextState(const State& state,
                       const std::string& action_call) const {
-  // Parse strings
-  const std::pair<Action, std::vector<Object>> action_args =
-      Action::Parse(*this, action_call);
-  const Action& action = action_args.first;
-  const std::vector<Object>& arguments = action_args.second;
-
-  return Apply(state, action, arguments, derived_predicates());
+  return NextState(state, ResolveAction(action_call));
+}
+State Pddl::NextState(const State& state,
+                      const GroundActionHandle& action) const {
+  return Apply(*this, state, actions_[action.idx_action], action.arguments);
 }
 
 TEST_CASE_FIXTURE(testing::Fixture, "Pddl.NextState") {
@@ -338,33 +620,229 @@ TEST_CASE_FIXTURE(testing::Fixture, "Pddl.NextState") {
   REQUIRE(pddl.NextState(state, "pick(hook)") == next_state);
 }
 
+std::vector<State> Pddl::NextStates(const std::vector<State>& states,
+                                    const std::vector<size_t>& actions,
+                                    ThreadPool* pool) const {
+  CheckBatch(*this, states.size(), actions, "Pddl::NextStates");
+  std::vector<State> next_states(states.size());
+  RunBatch(pool, states.size(), [&](size_t i) {
+    const GroundAction& action = ground_actions_[actions[i]];
+    next_states[i] =
+        Apply(*this, states[i], action.action(), action.arguments());
+  });
+  return next_states;
+}
+StateIndex::IndexedStates Pddl::NextStates(
+    // NOLINTNEXTLINE(performance-unnecessary-value-param)
+    Eigen::Ref<const StateIndex::IndexedStates> states,
+    const std::vector<size_t>& actions, ThreadPool* pool) const {
+  CheckBatch(*this, states.rows(), actions, "Pddl::NextStates");
+  if (static_cast<size_t>(states.cols()) != state_index_.size()) {
+    throw std::invalid_argument(
+        "Pddl::NextStates(): Indexed states must have " +
+        std::to_string(state_index_.size()) + " columns.");
+  }
+
+  // Ground actions don't apply axioms or derived predicates, so without them
+  // the indexed states can be updated directly.
+  const bool is_ground = axioms_.empty() && derived_predicates_.empty();
+  StateIndex::IndexedStates next_states(states.rows(), states.cols());
+  RunBatch(pool, actions.size(), [&](size_t i) {
+    const GroundAction& action = ground_actions_[actions[i]];
+    StateIndex::IndexedState state = states.row(i).transpose();
+    if (is_ground) {
+      action.Apply(&state);
+    } else {
+      state = state_index_.GetIndexedState(
+          Apply(*this, state_index_.GetState(state), action.action(),
+                action.arguments()));
+    }
+    next_states.row(i) = state.transpose();
+  });
+  return next_states;
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "Pddl.NextStates") {
+  ThreadPool pool(4);
+  const std::vector<GroundAction>& ground_actions = pddl.Ground();
+  const State& state = pddl.initial_state();
+  std::vector<State> states;
+  std::vector<size_t> actions;
+  for (const GroundAction& action : ground_actions) {
+    if (!action.action().IsValid(state, action.arguments())) continue;
+    states.push_back(state);
+    actions.push_back(action.id());
+  }
+  REQUIRE(!actions.empty());
+
+  const std::vector<State> next_states =
+      pddl.NextStates(states, actions, &pool);
+  StateIndex::IndexedStates indexed_states(states.size(),
+                                           pddl.state_index().size());
+  for (size_t i = 0; i < states.size(); i++) {
+    const GroundAction& action = ground_actions[actions[i]];
+    REQUIRE(next_states[i] ==
+            pddl.NextState(state, {actions[i], action.arguments()}));
+    indexed_states.row(i) =
+        pddl.state_index().GetIndexedState(states[i]).transpose();
+  }
+
+  const StateIndex::IndexedStates indexed_next_states =
+      pddl.NextStates(indexed_states, actions, &pool);
+  for (size_t i = 0; i < states.size(); i++) {
+    REQUIRE(pddl.state_index().GetState(
+                indexed_next_states.row(i).transpose()) == next_states[i]);
+  }
+  REQUIRE(pddl.IsValidTuples(states, actions, next_states, &pool) ==
+          std::vector<bool>(states.size(), true));
+  REQUIRE(pddl.IsValidTuples(indexed_states, actions, indexed_next_states,
+                             &pool)
+              .all());
+}
+
 State Pddl::ApplyActions(const State& state,
                          const std::vector<std::string>& action_calls) const {
+  return ApplyActions(state, ResolveActions(action_calls));
+}
+State Pddl::ApplyActions(const State& state,
+                         const std::vector<GroundActionHandle>& actions) const {
   State next_state(state);
-  for (const std::string& action_call : action_calls) {
-    const std::pair<Action, std::vector<Object>> action_args =
-        Action::Parse(*this, action_call);
-    const Action& action = action_args.first;
-    const std::vector<Object>& arguments = action_args.second;
-
-    Apply(action, arguments, derived_predicates(), &next_state);
+  for (size_t i = 0; i < actions.size(); i++) {
+    const Action& action = actions_[actions[i].idx_action];
+    const std::vector<Object>& arguments = actions[i].arguments;
+
+    // The derived predicates are only known to be up to date after the first
+    // action, so later ones can be applied incrementally.
+    if (i == 0) {
+      Apply(*this, action, arguments, &next_state);
+    } else {
+      ApplyAction(action, arguments, &next_state);
+    }
   }
   return next_state;
 }
 
+GroundActionHandle Pddl::ResolveAction(const std::string& action_call) const {
+  const std::string name_action = Proposition::ParseHead(action_call);
+  const auto it = idx_actions_.find(name_action);
+  if (it == idx_actions_.end()) {
+    throw std::invalid_argument("Pddl::ResolveAction(): Action " +
+                                name_action + " does not exist: " +
+                                action_call + ".");
+  }
+
+  GroundActionHandle handle{it->second,
+                            Object::ParseArguments(*this, action_call)};
+  actions_[handle.idx_action].CheckArguments(handle.arguments, action_call);
+  return handle;
+}
+
+std::vector<GroundActionHandle> Pddl::ResolveActions(
+    const std::vector<std::string>& action_calls) const {
+  std::vector<GroundActionHandle> actions;
+  actions.reserve(action_calls.size());
+  for (const std::string& action_call : action_calls) {
+    actions.push_back(ResolveAction(action_call));
+  }
+  return actions;
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "Pddl.ResolveAction") {
+  const GroundActionHandle action = pddl.ResolveAction("pick(hook)");
+  REQUIRE(pddl.actions()[action.idx_action].name() == "pick");
+  REQUIRE((action.arguments == std::vector<Object>{Object(pddl, "hook")}));
+  REQUIRE(pddl.NextState(pddl.initial_state(), action) ==
+          pddl.NextState(pddl.initial_state(), "pick(hook)"));
+  REQUIRE_THROWS(pddl.ResolveAction("fly(hook)"));
+  REQUIRE_THROWS(pddl.ResolveAction("pick(hook, box)"));
+}
+
 State Pddl::DerivedState(const State& state) const {
-  return DerivedPredicate::Apply(state, derived_predicates());
+  State next_state = state;
+  ApplyDerivedPredicates(&next_state);
+  return next_state;
+}
+
+bool Pddl::ApplyDerivedPredicates(State* state) const {
+  if (derived_program_.is_compiled()) return derived_program_.Apply(state);
+  return DerivedPredicate::Apply(derived_predicates_, state);
+}
+
+bool Pddl::ApplyDerivedPredicates(State* state, UndoLog* log) const {
+  if (derived_program_.is_compiled()) return derived_program_.Apply(state, log);
+  return DerivedPredicate::Apply(derived_predicates_, state, log);
+}
+
+bool Pddl::UpdateDerivedPredicates(
+    State* state, const std::vector<UndoLog::Entry>& changes) const {
+  if (!derived_program_.is_compiled()) return ApplyDerivedPredicates(state);
+  return derived_program_.Update(state, changes);
+}
+
+bool Pddl::UpdateDerivedPredicates(State* state, UndoLog* log) const {
+  if (!derived_program_.is_compiled()) {
+    return ApplyDerivedPredicates(state, log);
+  }
+  return derived_program_.Update(state, log);
+}
+
+bool Pddl::ApplyAction(const Action& action,
+                       const std::vector<Object>& arguments,
+                       State* state) const {
+  if (derived_predicates_.empty()) return action.Apply(arguments, state);
+
+  // Record the action's changes to use as the delta for the update.
+  UndoLog log;
+  action.ApplyInPlace(arguments, state, &log);
+  const bool is_changed = !log.entries().empty();
+  return UpdateDerivedPredicates(state, log.entries()) || is_changed;
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "Pddl.ApplyAction") {
+  const Action& pick = pddl.actions()[0];
+  State state = pddl.initial_state();
+  REQUIRE(pddl.ApplyAction(pick, {Object(pddl, "hook")}, &state));
+  REQUIRE(state == pddl.NextState(pddl.initial_state(), "pick(hook)"));
+}
+
+TEST_CASE_FIXTURE(testing::DerivedFixture, "Pddl.ApplyAction.Derived") {
+  // Each action adds or deletes an on or ontable proposition.
+  const std::vector<std::string> plan = {"unstack(a, b)", "putdown(a)",
+                                         "unstack(b, c)", "stack(b, a)",
+                                         "pick(c)",       "stack(c, b)"};
+
+  // Keep the non-derived propositions separately to derive from scratch.
+  State base = pddl.initial_state();
+  State state = pddl.DerivedState(base);
+  for (const std::string& action_call : plan) {
+    const std::pair<Action, std::vector<Object>> action_args =
+        Action::Parse(pddl, action_call);
+    const Action& action = action_args.first;
+    const std::vector<Object>& arguments = action_args.second;
+    REQUIRE(action.IsValid(state, arguments));
+
+    // Update the derived predicates in place with the undo log.
+    State in_place = state;
+    UndoLog log;
+    action.ApplyInPlace(arguments, &in_place, &log);
+    pddl.UpdateDerivedPredicates(&in_place, &log);
+
+    // Update the derived predicates incrementally after the action.
+    const State prev_state = state;
+    REQUIRE(pddl.ApplyAction(action, arguments, &state));
+    action.Apply(arguments, &base);
+    REQUIRE(state == DerivedPredicate::Apply(base, pddl.derived_predicates()));
+    REQUIRE(in_place == state);
+
+    Action::Undo(&in_place, &log);
+    REQUIRE(in_place == prev_state);
+  }
+  REQUIRE(pddl.goal()(state));
 }
 
 State Pddl::ConsistentState(const State& state) const {
   State next_state = state;
-  bool is_changed = true;
-  while (is_changed) {
-    is_changed = false;
-    for (const std::shared_ptr<Axiom>& axiom : axioms()) {
-      is_changed |= axiom->Apply(&next_state);
-    }
-  }
+  CloseAxioms(*this, &next_state, false);
   return next_state;
 }
 
@@ -400,13 +878,11 @@ PartialState Pddl::ConsistentState(const PartialState& state) const {
 
 bool Pddl::IsValidAction(const State& state,
                          const std::string& action_call) const {
-  // Parse strings
-  const std::pair<Action, std::vector<Object>> action_args =
-      Action::Parse(*this, action_call);
-  const Action& action = action_args.first;
-  const std::vector<Object>& arguments = action_args.second;
-
-  return action.IsValid(state, arguments);
+  return IsValidAction(state, ResolveAction(action_call));
+}
+bool Pddl::IsValidAction(const State& state,
+                         const GroundActionHandle& action) const {
+  return actions_[action.idx_action].IsValid(state, action.arguments);
 }
 
 TEST_CASE_FIXTURE(testing::Fixture, "Pddl.IsValidAction") {
@@ -416,26 +892,51 @@ TEST_CASE_FIXTURE(testing::Fixture, "Pddl.IsValidAction") {
 }
 
 bool Pddl::IsValidState(const State& state) const {
-  for (const std::shared_ptr<Axiom>& axiom : axioms()) {
-    if (!axiom->IsConsistent(state)) return false;
+  // The state is valid if no axiom changes it.
+  State test_state = state;
+  try {
+    return !CloseAxioms(*this, &test_state, true);
+  } catch (const std::exception& e) {
+    return false;
   }
-  return true;
 }
 
 bool Pddl::IsValidState(const PartialState& state) const {
   return Axiom::IsConsistent(axioms(), state);
 }
 
+TEST_CASE_FIXTURE(testing::AxiomsFixture, "Pddl.ConsistentState") {
+  const State state(pddl, {"inhand(a)", "ontable(a)", "supported(a)",
+                           "ontable(b)", "supported(b)", "clear(b)",
+                           "on(c, b)", "supported(c)"});
+
+  // Apply every axiom until none of them changes the state.
+  State fixpoint = state;
+  for (bool is_changed = true; is_changed;) {
+    is_changed = false;
+    for (const std::shared_ptr<Axiom>& axiom : pddl.axioms()) {
+      is_changed |= axiom->Apply(&fixpoint);
+    }
+  }
+  REQUIRE((fixpoint == State(pddl, {"inhand(a)", "ontable(b)", "supported(b)",
+                                    "on(c, b)"})));
+
+  // Removing ontable(a) triggers the negative context axiom again after it
+  // has been applied in full.
+  REQUIRE(pddl.ConsistentState(state) == fixpoint);
+  REQUIRE(pddl.initial_state() == fixpoint);
+
+  // Validation returns as soon as any axiom changes the state.
+  REQUIRE(!pddl.IsValidState(state));
+  REQUIRE(!pddl.IsValidState(State(pddl, {"supported(a)"})));
+  REQUIRE(!pddl.IsValidState(State(pddl, {"on(a, b)", "clear(b)",
+                                          "ontable(a)", "supported(a)"})));
+  REQUIRE(pddl.IsValidState(fixpoint));
+}
+
 bool Pddl::IsValidTuple(const State& state, const std::string& action_call,
                         const State& next_state) const {
-  // Parse strings
-  const std::pair<Action, std::vector<Object>> action_args =
-      Action::Parse(*this, action_call);
-  const Action& action = action_args.first;
-  const std::vector<Object>& arguments = action_args.second;
-
-  return action.IsValid(state, arguments) &&
-         Apply(state, action, arguments, derived_predicates()) == next_state;
+  return IsValidTuple(state, ResolveAction(action_call), next_state);
 }
 bool Pddl::IsValidTuple(const std::set<std::string>& str_state,
                         const std::string& action_call,
@@ -445,6 +946,72 @@ bool Pddl::IsValidTuple(const std::set<std::string>& str_state,
   const State next_state = ParseState(*this, str_next_state);
   return IsValidTuple(state, action_call, next_state);
 }
+bool Pddl::IsValidTuple(const State& state, const GroundActionHandle& action,
+                        const State& next_state) const {
+  return IsValidAction(state, action) &&
+         NextState(state, action) == next_state;
+}
+
+std::vector<bool> Pddl::IsValidTuples(const std::vector<State>& states,
+                                      const std::vector<size_t>& actions,
+                                      const std::vector<State>& next_states,
+                                      ThreadPool* pool) const {
+  CheckBatch(*this, states.size(), actions, "Pddl::IsValidTuples");
+  if (next_states.size() != states.size()) {
+    throw std::invalid_argument(
+        "Pddl::IsValidTuples(): Received different numbers of states and next "
+        "states.");
+  }
+
+  // Threads can't write to a std::vector<bool> concurrently.
+  std::vector<char> is_valid(states.size());
+  RunBatch(pool, states.size(), [&](size_t i) {
+    const GroundAction& action = ground_actions_[actions[i]];
+    is_valid[i] =
+        action.action().IsValid(states[i], action.arguments()) &&
+        Apply(*this, states[i], action.action(), action.arguments()) ==
+            next_states[i];
+  });
+  return std::vector<bool>(is_valid.begin(), is_valid.end());
+}
+Eigen::Array<bool, Eigen::Dynamic, 1> Pddl::IsValidTuples(
+    // NOLINTNEXTLINE(performance-unnecessary-value-param)
+    Eigen::Ref<const StateIndex::IndexedStates> states,
+    const std::vector<size_t>& actions,
+    // NOLINTNEXTLINE(performance-unnecessary-value-param)
+    Eigen::Ref<const StateIndex::IndexedStates> next_states,
+    ThreadPool* pool) const {
+  CheckBatch(*this, states.rows(), actions, "Pddl::IsValidTuples");
+  if (static_cast<size_t>(states.cols()) != state_index_.size() ||
+      next_states.rows() != states.rows() ||
+      next_states.cols() != states.cols()) {
+    throw std::invalid_argument(
+        "Pddl::IsValidTuples(): States and next states must both have " +
+        std::to_string(states.rows()) + " rows and " +
+        std::to_string(state_index_.size()) + " columns.");
+  }
+
+  // Ground actions don't apply axioms or derived predicates, so without them
+  // the indexed states can be checked directly.
+  const bool is_ground = axioms_.empty() && derived_predicates_.empty();
+  Eigen::Array<bool, Eigen::Dynamic, 1> is_valid(states.rows());
+  RunBatch(pool, actions.size(), [&](size_t i) {
+    const GroundAction& action = ground_actions_[actions[i]];
+    StateIndex::IndexedState state = states.row(i).transpose();
+    is_valid(i) = false;
+    if (is_ground) {
+      if (!action.IsApplicable(state)) return;
+      action.Apply(&state);
+    } else {
+      const State full_state = state_index_.GetState(state);
+      if (!action.action().IsValid(full_state, action.arguments())) return;
+      state = state_index_.GetIndexedState(
+          Apply(*this, full_state, action.action(), action.arguments()));
+    }
+    is_valid(i) = (state == next_states.row(i).transpose()).all();
+  });
+  return is_valid;
+}
 
 bool Pddl::IsGoalSatisfied(const std::set<std::string>& str_state) const {
   // Parse strings
@@ -453,17 +1020,26 @@ bool Pddl::IsGoalSatisfied(const std::set<std::string>& str_state) const {
   return goal_(state);
 }
 
+size_t Pddl::CountUnsatisfiedGoals(const std::set<std::string>& str_state,
+                                   std::vector<bool>* satisfied) const {
+  // Parse strings
+  const State state = ParseState(*this, str_state);
+
+  return goal_.CountUnsatisfied(state, satisfied);
+}
+
 bool Pddl::IsValidPlan(const std::vector<std::string>& action_skeleton) const {
-  State state = initial_state_;
-  for (const std::string& action_call : action_skeleton) {
-    // Parse strings
-    std::pair<Action, std::vector<Object>> action_args =
-        Action::Parse(*this, action_call);
-    const Action& action = action_args.first;
-    const std::vector<Object>& arguments = action_args.second;
+  return IsValidPlan(ResolveActions(action_skeleton));
+}
+bool Pddl::IsValidPlan(
+    const std::vector<GroundActionHandle>& action_skeleton) const {
+  State state = DerivedState(initial_state_);
+  for (const GroundActionHandle& action_call : action_skeleton) {
+    const Action& action = actions_[action_call.idx_action];
+    const std::vector<Object>& arguments = action_call.arguments;
 
     if (!action.IsValid(state, arguments)) return false;
-    Apply(action, arguments, derived_predicates(), &state);
+    Apply(*this, action, arguments, &state);
   }
   return goal_(state);
 }
@@ -513,6 +1089,192 @@ std::vector<std::string> Pddl::ListValidActions(
   return ListValidActions(ParseState(*this, state));
 }
 
+std::vector<std::vector<Object>> Pddl::ListValidArguments(
+    const State& state, const Action& action, ThreadPool* pool) const {
+  const std::vector<ParameterGenerator> param_gens = {
+      ParameterGenerator(*this, action.parameters())};
+  return ListValid<std::vector<Object>>(
+      state, {&action}, param_gens, pool,
+      [](const Action& /*action*/, const std::vector<Object>& arguments) {
+        return arguments;
+      });
+}
+
+std::vector<std::string> Pddl::ListValidActions(const State& state,
+                                                ThreadPool* pool) const {
+  std::vector<const Action*> actions;
+  std::vector<ParameterGenerator> param_gens;
+  actions.reserve(actions_.size());
+  param_gens.reserve(actions_.size());
+  for (const Action& action : actions_) {
+    actions.push_back(&action);
+    param_gens.emplace_back(*this, action.parameters());
+  }
+  return ListValid<std::string>(
+      state, actions, param_gens, pool,
+      [](const Action& action, const std::vector<Object>& arguments) {
+        return action.to_string(arguments);
+      });
+}
+
+std::vector<std::string> Pddl::ListValidActions(
+    const std::set<std::string>& state, ThreadPool* pool) const {
+  return ListValidActions(ParseState(*this, state), pool);
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "Pddl.ListValidActions") {
+  ThreadPool pool(4);
+  State state = pddl.initial_state();
+  const std::vector<std::string> action_calls = {"pick(hook)",
+                                                 "push(hook, box, table)"};
+  for (const std::string& action_call : action_calls) {
+    REQUIRE(pddl.ListValidActions(state, &pool) ==
+            pddl.ListValidActions(state));
+    state = pddl.NextState(state, action_call);
+  }
+  const Action& place = pddl.actions()[1];
+  REQUIRE(pddl.ListValidArguments(state, place, &pool) ==
+          pddl.ListValidArguments(state, place));
+}
+
+void Pddl::set_formula_profiling(bool profiling) {
+  for (Action& action : actions_) {
+    action.preconditions().set_profiling(profiling);
+  }
+  goal_.set_profiling(profiling);
+}
+
+void Pddl::ReorderConjuncts() {
+  for (Action& action : actions_) {
+    Formula& preconditions = action.preconditions();
+    if (preconditions.profiling()) preconditions.ReorderConjunctsByFailureRate();
+  }
+  if (goal_.profiling()) goal_.ReorderConjunctsByFailureRate();
+}
+
+void Pddl::SaveConjunctOrder(const std::string& filename) const {
+  std::ofstream file(filename);
+  if (!file) {
+    throw std::runtime_error("Pddl::SaveConjunctOrder(): Unable to open " +
+                             filename + ".");
+  }
+  for (const Action& action : actions_) {
+    file << action.name();
+    for (const size_t idx : action.preconditions().conjunct_order()) {
+      file << " " << idx;
+    }
+    file << std::endl;
+  }
+}
+
+void Pddl::LoadConjunctOrder(const std::string& filename) {
+  std::ifstream file(filename);
+  if (!file) {
+    throw std::runtime_error("Pddl::LoadConjunctOrder(): Unable to open " +
+                             filename + ".");
+  }
+  std::string line;
+  while (std::getline(file, line)) {
+    std::stringstream ss(line);
+    std::string name_action;
+    if (!(ss >> name_action)) continue;
+
+    std::vector<size_t> order;
+    size_t idx;
+    while (ss >> idx) order.push_back(idx);
+
+    auto it = std::find_if(
+        actions_.begin(), actions_.end(),
+        [&name_action](const Action& action) {
+          return action.name() == name_action;
+        });
+    if (it == actions_.end()) {
+      throw std::runtime_error("Pddl::LoadConjunctOrder(): Unknown action " +
+                               name_action + ".");
+    }
+    it->preconditions().ReorderConjuncts(order);
+  }
+}
+
+void Pddl::set_initial_state(State&& state) {
+  initial_state_ = std::move(state);
+  State static_state = GetStaticState(*this, initial_state_);
+  if (static_state == static_state_) return;
+  static_state_ = std::move(static_state);
+
+  // Ground actions were pruned with the old static propositions.
+  ClearGroundActions();
+}
+
+void Pddl::ClearGroundActions() {
+  is_grounded_ = false;
+  ground_actions_.clear();
+  successor_generator_ = SuccessorGenerator();
+  relevance_index_.ClearGroundActions();
+}
+
+const std::vector<GroundAction>& Pddl::Ground() {
+  if (!is_grounded_) {
+    ground_actions_ = GroundAction::Ground(*this);
+    successor_generator_ = SuccessorGenerator(ground_actions_);
+    relevance_index_.IndexGroundActions(state_index_.size(), ground_actions_);
+    is_grounded_ = true;
+  }
+  return ground_actions_;
+}
+
+std::vector<size_t> Pddl::ListApplicableGroundActions(
+    const State& state) const {
+  if (!is_grounded_) {
+    throw std::runtime_error(
+        "Pddl::ListApplicableGroundActions(): Actions have not been grounded.");
+  }
+  return successor_generator_.GetApplicableActions(
+      state_index_.GetIndexedState(state));
+}
+
+Reachability Pddl::AnalyzeReachability(bool prune) {
+  Reachability reachability = Reachability::Compute(*this, Ground());
+  if (!prune || reachability.actions.size() == ground_actions_.size()) {
+    return reachability;
+  }
+
+  // Collect the arguments of the reachable ground actions.
+  std::unordered_map<const Action*, std::vector<std::unordered_set<Object>>>
+      action_args;
+  for (Action& action : actions_) {
+    action_args[&action].resize(action.parameters().size());
+  }
+  for (const size_t id : reachability.actions) {
+    const GroundAction& ground_action = ground_actions_[id];
+    std::vector<std::unordered_set<Object>>& args =
+        action_args.at(&ground_action.action());
+    for (size_t i = 0; i < args.size(); i++) {
+      args[i].insert(ground_action.arguments()[i]);
+    }
+  }
+
+  // Restrict the parameter domains.
+  for (Action& action : actions_) {
+    const std::vector<std::unordered_set<Object>>& args =
+        action_args.at(&action);
+    for (size_t i = 0; i < args.size(); i++) {
+      action.parameter_generator().Restrict(
+          i, [&objects = args[i]](const Object& object) {
+            return objects.find(object) != objects.end();
+          });
+    }
+  }
+
+  ground_actions_ = GroundAction::Select(ground_actions_, reachability.actions);
+  successor_generator_ = SuccessorGenerator(ground_actions_);
+  relevance_index_.IndexGroundActions(state_index_.size(), ground_actions_);
+  for (size_t i = 0; i < reachability.actions.size(); i++) {
+    reachability.actions[i] = i;
+  }
+  return reachability;
+}
+
 void Pddl::AddObject(const std::string& name, const std::string& type) {
   VAL::const_symbol* symbol = new VAL::const_symbol(name);
   for (VAL::pddl_type* type_symbol : *analysis_->the_domain->types) {
@@ -522,6 +1284,10 @@ void Pddl::AddObject(const std::string& name, const std::string& type) {
   }
   analysis_->the_problem->objects->push_back(symbol);
   objects_.emplace_back(*this, symbol);
+  object_names_.emplace(name, objects_.back());
+
+  // Ground actions are no longer complete.
+  ClearGroundActions();
 }
 
 void Pddl::RemoveObject(const std::string& name) {
@@ -529,6 +1295,7 @@ void Pddl::RemoveObject(const std::string& name) {
     if (it->name() != name) continue;
     const VAL::pddl_typed_symbol* symbol = it->symbol();
     objects_.erase(it);
+    object_names_.erase(name);
 
     VAL::const_symbol_list* objects = analysis_->the_problem->objects;
     for (auto itt = objects->begin(); itt != objects->end(); ++itt) {
@@ -538,6 +1305,9 @@ void Pddl::RemoveObject(const std::string& name) {
     }
 
     delete symbol;
+
+    // Ground actions may refer to the removed object.
+    ClearGroundActions();
     break;
   }
 }
@@ -0,0 +1,213 @@
+/**
+ * best_first_search.cc
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#include "symbolic/planning/best_first_search.h"
+
+#include <algorithm>      // std::reverse
+#include <exception>      // std::invalid_argument, std::runtime_error
+#include <limits>         // std::numeric_limits
+#include <queue>          // std::priority_queue
+#include <unordered_set>  // std::unordered_set
+#include <utility>        // std::move
+
+#include "symbolic/planning/relaxation_heuristic.h"
+#include "utils/doctest.h"
+
+namespace {
+
+using ::symbolic::StateIndex;
+
+constexpr size_t kNoParent = std::numeric_limits<size_t>::max();
+
+struct Node {
+  StateIndex::IndexedState state;
+  size_t hash;
+  size_t idx_parent;
+  size_t id_action;
+  size_t g;
+  size_t h;
+};
+
+struct OpenEntry {
+  double f;
+  size_t h;
+  size_t idx_node;
+};
+
+// Orders the priority queue by lowest f, then lowest h, then FIFO.
+struct OpenCompare {
+  bool operator()(const OpenEntry& lhs, const OpenEntry& rhs) const {
+    if (lhs.f != rhs.f) return lhs.f > rhs.f;
+    if (lhs.h != rhs.h) return lhs.h > rhs.h;
+    return lhs.idx_node > rhs.idx_node;
+  }
+};
+
+// Closed list hashes and compares node indices by their states, so that each
+// state is stored only once in the node table.
+struct NodeHash {
+  const std::vector<Node>* nodes;
+  size_t operator()(size_t idx_node) const { return (*nodes)[idx_node].hash; }
+};
+
+struct NodeEqual {
+  const std::vector<Node>* nodes;
+  bool operator()(size_t lhs, size_t rhs) const {
+    return StateIndex::IndexedStateEqual{}((*nodes)[lhs].state,
+                                           (*nodes)[rhs].state);
+  }
+};
+
+}  // namespace
+
+namespace symbolic {
+
+BestFirstSearch::BestFirstSearch(const Pddl& pddl, Heuristic heuristic,
+                                 double weight)
+    : pddl_(pddl),
+      heuristic_(std::move(heuristic)),
+      weight_(weight),
+      goal_(GroundAction::GroundGoal(pddl)) {
+  if (!pddl.is_grounded()) {
+    throw std::runtime_error(
+        "BestFirstSearch::BestFirstSearch(): Actions have not been grounded.");
+  }
+  if (!heuristic_) {
+    throw std::invalid_argument(
+        "BestFirstSearch::BestFirstSearch(): Heuristic is empty.");
+  }
+  if (weight < 0.) {
+    throw std::invalid_argument(
+        "BestFirstSearch::BestFirstSearch(): Weight must be non-negative.");
+  }
+}
+
+std::optional<std::vector<std::string>> BestFirstSearch::Search(
+    const State& state, size_t max_expansions) {
+  const std::vector<GroundAction>& actions = pddl_.ground_actions();
+
+  statistics_ = Statistics();
+  std::vector<Node> nodes;
+  std::unordered_set<size_t, NodeHash, NodeEqual> closed(
+      0, NodeHash{&nodes}, NodeEqual{&nodes});
+  std::priority_queue<OpenEntry, std::vector<OpenEntry>, OpenCompare> open;
+
+  // Adds the node at the back of the table, or merges it into the node with
+  // the same state if it was reached more cheaply.
+  const auto Push = [&]() {
+    Node& node = nodes.back();
+    const size_t idx_node = nodes.size() - 1;
+    const auto it_closed = closed.find(idx_node);
+    if (it_closed != closed.end()) {
+      Node& other = nodes[*it_closed];
+      const bool is_cheaper = node.g < other.g;
+      if (is_cheaper) {
+        other.idx_parent = node.idx_parent;
+        other.id_action = node.id_action;
+        other.g = node.g;
+      }
+      nodes.pop_back();
+      if (!is_cheaper) return;
+      statistics_.num_reopened++;
+      open.push({other.g + weight_ * other.h, other.h, *it_closed});
+      return;
+    }
+
+    node.h = heuristic_(node.state);
+    if (node.h == RelaxationHeuristic::kInfinity) {
+      nodes.pop_back();
+      return;
+    }
+    closed.insert(idx_node);
+    open.push({node.g + weight_ * node.h, node.h, idx_node});
+  };
+
+  StateIndex::IndexedState root = GroundAction::GetRoot(pddl_, state);
+  const size_t hash_root = StateIndex::IndexedStateHash{}(root);
+  nodes.push_back({std::move(root), hash_root, kNoParent, 0, 0, 0});
+  Push();
+
+  while (!open.empty()) {
+    const OpenEntry top = open.top();
+    open.pop();
+
+    // Skip entries superseded by a cheaper path to the same state.
+    if (top.f != nodes[top.idx_node].g + weight_ * nodes[top.idx_node].h) {
+      continue;
+    }
+
+    if (GroundAction::IsGoal(goal_, nodes[top.idx_node].state)) {
+      std::vector<std::string> plan;
+      for (size_t idx = top.idx_node; nodes[idx].idx_parent != kNoParent;
+           idx = nodes[idx].idx_parent) {
+        plan.push_back(actions[nodes[idx].id_action].to_string());
+      }
+      std::reverse(plan.begin(), plan.end());
+      return plan;
+    }
+
+    if (max_expansions > 0 && statistics_.num_expanded >= max_expansions) {
+      break;
+    }
+    statistics_.num_expanded++;
+
+    // Copy the parent since the node table may be reallocated.
+    const StateIndex::IndexedState parent = nodes[top.idx_node].state;
+    const size_t g = nodes[top.idx_node].g + 1;
+    for (const size_t id_action :
+         pddl_.successor_generator().GetApplicableActions(parent)) {
+      StateIndex::IndexedState next = parent;
+      actions[id_action].Apply(pddl_, &next);
+      statistics_.num_generated++;
+
+      const size_t hash = StateIndex::IndexedStateHash{}(next);
+      nodes.push_back({std::move(next), hash, top.idx_node, id_action, g, 0});
+      Push();
+    }
+  }
+  return {};
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "BestFirstSearch") {
+  pddl.Ground();
+  const State& state = pddl.initial_state();
+  for (const RelaxationHeuristic::Type type :
+       {RelaxationHeuristic::Type::kAdd, RelaxationHeuristic::Type::kMax,
+        RelaxationHeuristic::Type::kFF}) {
+    const RelaxationHeuristic heuristic(pddl, type);
+    BestFirstSearch search(
+        pddl, [&heuristic](const StateIndex::IndexedState& s) {
+          return heuristic(s);
+        });
+    const std::optional<std::vector<std::string>> plan = search.Search(state);
+    REQUIRE(plan.has_value());
+    REQUIRE(pddl.IsValidPlan(*plan));
+
+    // A* with the admissible h_max finds the shortest plan.
+    if (type == RelaxationHeuristic::Type::kMax) REQUIRE(plan->size() == 5);
+  }
+}
+
+TEST_CASE_FIXTURE(testing::DerivedFixture, "BestFirstSearch.Derived") {
+  pddl.Ground();
+
+  // The relaxed task ignores derived predicates, so search without a
+  // heuristic.
+  BestFirstSearch search(pddl,
+                         [](const StateIndex::IndexedState& /*state*/) {
+                           return size_t{0};
+                         });
+  const std::optional<std::vector<std::string>> plan =
+      search.Search(pddl.initial_state());
+  REQUIRE(plan.has_value());
+  REQUIRE(plan->size() == 6);
+  REQUIRE(pddl.IsValidPlan(*plan));
+}
+
+}  // namespace symbolic
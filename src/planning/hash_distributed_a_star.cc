@@ -0,0 +1,379 @@
+/**
+ * hash_distributed_a_star.cc
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#include "symbolic/planning/hash_distributed_a_star.h"
+
+#include <algorithm>      // std::reverse, std::sort, std::unique
+#include <atomic>         // std::atomic
+#include <chrono>         // std::chrono
+#include <exception>      // std::invalid_argument, std::runtime_error
+#include <limits>         // std::numeric_limits
+#include <mutex>          // std::lock_guard, std::mutex
+#include <queue>          // std::priority_queue
+#include <random>         // std::mt19937_64
+#include <thread>         // std::this_thread
+#include <unordered_set>  // std::unordered_set
+#include <utility>        // std::move
+
+#include "symbolic/planning/relaxation_heuristic.h"
+#include "symbolic/utils/mpsc_queue.h"
+#include "utils/doctest.h"
+
+namespace {
+
+using ::symbolic::GroundAction;
+using ::symbolic::GroundConditionalEffect;
+using ::symbolic::MpscQueue;
+using ::symbolic::StateIndex;
+
+constexpr size_t kNone = std::numeric_limits<size_t>::max();
+
+// Longest sleep of an idle worker between checks of its inbox.
+constexpr std::chrono::microseconds kMaxBackoff(1000);
+
+// Node in the table of the worker that owns it. Parents may be owned by other
+// workers.
+struct Node {
+  StateIndex::IndexedState state;
+  size_t hash;
+  size_t idx_parent_worker;
+  size_t idx_parent;
+  size_t id_action;
+  size_t g;
+  size_t h;
+};
+
+// Generated successor sent to its owner.
+using Message = Node;
+
+struct OpenEntry {
+  size_t f;
+  size_t h;
+  size_t g;
+  size_t idx_node;
+};
+
+// Orders the priority queue by lowest f, then lowest h.
+struct OpenCompare {
+  bool operator()(const OpenEntry& lhs, const OpenEntry& rhs) const {
+    if (lhs.f != rhs.f) return lhs.f > rhs.f;
+    if (lhs.h != rhs.h) return lhs.h > rhs.h;
+    return lhs.idx_node > rhs.idx_node;
+  }
+};
+
+struct NodeHash {
+  const std::vector<Node>* nodes;
+  size_t operator()(size_t idx_node) const { return (*nodes)[idx_node].hash; }
+};
+
+struct NodeEqual {
+  const std::vector<Node>* nodes;
+  bool operator()(size_t lhs, size_t rhs) const {
+    return StateIndex::IndexedStateEqual{}((*nodes)[lhs].state,
+                                           (*nodes)[rhs].state);
+  }
+};
+
+struct Worker {
+  Worker() : closed(0, NodeHash{&nodes}, NodeEqual{&nodes}) {}
+
+  std::vector<Node> nodes;
+  std::unordered_set<size_t, NodeHash, NodeEqual> closed;
+  std::priority_queue<OpenEntry, std::vector<OpenEntry>, OpenCompare> open;
+  MpscQueue<Message> inbox;
+  size_t num_generated = 0;
+};
+
+size_t Hash(const std::vector<size_t>& keys,
+            const StateIndex::IndexedState& state) {
+  size_t hash = 0;
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (state[i]) hash ^= keys[i];
+  }
+  return hash;
+}
+
+/**
+ * Updates the hash with the propositions changed by the action.
+ */
+size_t UpdateHash(const std::vector<size_t>& keys, const GroundAction& action,
+                  const StateIndex::IndexedState& state,
+                  const StateIndex::IndexedState& next_state, size_t hash) {
+  // A proposition may appear in several effects but must only flip once.
+  std::vector<size_t> changed;
+  const auto AddChanged = [&](const std::vector<size_t>& props) {
+    for (const size_t idx_prop : props) {
+      if (state[idx_prop] != next_state[idx_prop]) changed.push_back(idx_prop);
+    }
+  };
+  AddChanged(action.add_effects());
+  AddChanged(action.del_effects());
+  for (const GroundConditionalEffect& effect : action.conditional_effects()) {
+    AddChanged(effect.add_effects);
+    AddChanged(effect.del_effects);
+  }
+  std::sort(changed.begin(), changed.end());
+  changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+  for (const size_t idx_prop : changed) hash ^= keys[idx_prop];
+  return hash;
+}
+
+}  // namespace
+
+namespace symbolic {
+
+HashDistributedAStar::HashDistributedAStar(
+    const Pddl& pddl, BestFirstSearch::Heuristic heuristic, ThreadPool* pool)
+    : pddl_(pddl),
+      heuristic_(std::move(heuristic)),
+      pool_(pool),
+      goal_(GroundAction::GroundGoal(pddl)) {
+  if (!pddl.is_grounded()) {
+    throw std::runtime_error(
+        "HashDistributedAStar::HashDistributedAStar(): Actions have not been "
+        "grounded.");
+  }
+  if (!heuristic_) {
+    throw std::invalid_argument(
+        "HashDistributedAStar::HashDistributedAStar(): Heuristic is empty.");
+  }
+  if (pool == nullptr) {
+    throw std::invalid_argument(
+        "HashDistributedAStar::HashDistributedAStar(): Thread pool is null.");
+  }
+
+  // Fixed seed so that the work distribution is reproducible.
+  std::mt19937_64 generator(pddl.state_index().size());
+  keys_.resize(pddl.state_index().size());
+  for (size_t& key : keys_) key = generator();
+}
+
+std::optional<std::vector<std::string>> HashDistributedAStar::Search(
+    const State& state, size_t max_expansions) {
+  const std::vector<GroundAction>& actions = pddl_.ground_actions();
+
+  // Ground actions don't apply axioms or derived predicates, so without them
+  // the hashes can be updated incrementally.
+  const bool is_ground = GroundAction::IsDerivationFree(pddl_);
+
+  const size_t num_workers = pool_->num_threads();
+  std::vector<Worker> workers(num_workers);
+
+  // Termination is detected when all of the workers are idle and every sent
+  // message has been received.
+  std::atomic<size_t> num_idle{0};
+  std::atomic<size_t> num_sent{0};
+  std::atomic<size_t> num_received{0};
+  std::atomic<size_t> num_expanded{0};
+  std::atomic<bool> is_done{false};
+  std::atomic<bool> is_aborted{false};
+
+  // Cost and node of the best plan found so far.
+  std::atomic<size_t> incumbent{kNone};
+  std::mutex mtx_incumbent;
+  size_t idx_goal_worker = kNone;
+  size_t idx_goal = kNone;
+
+  // Adds the message to the table of its owner, or updates the node with the
+  // same state if it was reached more cheaply.
+  const auto Receive = [this](Worker& worker, Message&& message) {
+    std::vector<Node>& nodes = worker.nodes;
+    nodes.push_back(std::move(message));
+    const size_t idx_node = nodes.size() - 1;
+    const auto it_closed = worker.closed.find(idx_node);
+    if (it_closed != worker.closed.end()) {
+      Node& other = nodes[*it_closed];
+      const bool is_cheaper = nodes.back().g < other.g;
+      if (is_cheaper) {
+        other.idx_parent_worker = nodes.back().idx_parent_worker;
+        other.idx_parent = nodes.back().idx_parent;
+        other.id_action = nodes.back().id_action;
+        other.g = nodes.back().g;
+      }
+      nodes.pop_back();
+      if (!is_cheaper || other.h == RelaxationHeuristic::kInfinity) return;
+      worker.open.push({other.g + other.h, other.h, other.g, *it_closed});
+      return;
+    }
+
+    // Dead ends stay in the closed list so that they aren't evaluated again.
+    Node& node = nodes.back();
+    node.h = heuristic_(node.state);
+    worker.closed.insert(idx_node);
+    if (node.h == RelaxationHeuristic::kInfinity) return;
+    worker.open.push({node.g + node.h, node.h, node.g, idx_node});
+  };
+
+  StateIndex::IndexedState root = GroundAction::GetRoot(pddl_, state);
+  const size_t hash_root = Hash(keys_, root);
+  Receive(workers[hash_root % num_workers],
+          {std::move(root), hash_root, kNone, kNone, 0, 0, 0});
+
+  pool_->Run(num_workers, [&](size_t idx_worker) {
+    Worker& worker = workers[idx_worker];
+    std::vector<Message> messages;
+    bool is_idle = false;
+    std::chrono::microseconds backoff(0);
+    try {
+      while (!is_done.load(std::memory_order_acquire)) {
+        messages.clear();
+        if (worker.inbox.PopAll(&messages) > 0) {
+          if (is_idle) {
+            is_idle = false;
+            backoff = std::chrono::microseconds(0);
+            num_idle.fetch_sub(1, std::memory_order_acq_rel);
+          }
+          for (Message& message : messages) {
+            Receive(worker, std::move(message));
+          }
+          num_received.fetch_add(messages.size(), std::memory_order_acq_rel);
+        }
+
+        // Find the next node below the incumbent cost. Nodes at or above it
+        // can't lead to a cheaper plan since the incumbent only decreases.
+        size_t idx_node = kNone;
+        while (!worker.open.empty()) {
+          const OpenEntry top = worker.open.top();
+          if (top.f >= incumbent.load(std::memory_order_acquire)) break;
+          worker.open.pop();
+          if (top.g != worker.nodes[top.idx_node].g) continue;  // Stale
+          idx_node = top.idx_node;
+          break;
+        }
+
+        if (idx_node == kNone) {
+          if (!is_idle) {
+            is_idle = true;
+            num_idle.fetch_add(1, std::memory_order_acq_rel);
+          }
+          // Read the received count before the sent count, so that equal
+          // counts mean no message was in flight in between.
+          const size_t received = num_received.load(std::memory_order_acquire);
+          if (num_idle.load(std::memory_order_acquire) == num_workers &&
+              num_sent.load(std::memory_order_acquire) == received) {
+            is_done.store(true, std::memory_order_release);
+          } else if (backoff.count() == 0) {
+            std::this_thread::yield();
+            backoff = std::chrono::microseconds(1);
+          } else {
+            // Back off exponentially so that idle workers don't compete with
+            // busy ones for cores.
+            std::this_thread::sleep_for(backoff);
+            backoff = std::min(2 * backoff, kMaxBackoff);
+          }
+          continue;
+        }
+
+        // Copy the node since receiving may reallocate the table.
+        const Node node = worker.nodes[idx_node];
+        if (GroundAction::IsGoal(goal_, node.state)) {
+          std::lock_guard<std::mutex> lock(mtx_incumbent);
+          if (node.g < incumbent.load(std::memory_order_acquire)) {
+            incumbent.store(node.g, std::memory_order_release);
+            idx_goal_worker = idx_worker;
+            idx_goal = idx_node;
+          }
+          continue;
+        }
+
+        if (max_expansions > 0 &&
+            num_expanded.fetch_add(1, std::memory_order_relaxed) >=
+                max_expansions) {
+          is_aborted.store(true, std::memory_order_relaxed);
+          is_done.store(true, std::memory_order_release);
+          break;
+        }
+        if (max_expansions == 0) {
+          num_expanded.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        for (const size_t id_action :
+             pddl_.successor_generator().GetApplicableActions(node.state)) {
+          const GroundAction& action = actions[id_action];
+          Message message = {node.state, 0,          idx_worker, idx_node,
+                             id_action,  node.g + 1, 0};
+          action.Apply(pddl_, &message.state);
+          message.hash =
+              is_ground ? UpdateHash(keys_, action, node.state, message.state,
+                                     node.hash)
+                        : Hash(keys_, message.state);
+          worker.num_generated++;
+
+          const size_t idx_owner = message.hash % num_workers;
+          if (idx_owner == idx_worker) {
+            Receive(worker, std::move(message));
+            continue;
+          }
+          num_sent.fetch_add(1, std::memory_order_acq_rel);
+          workers[idx_owner].inbox.Push(std::move(message));
+        }
+      }
+    } catch (...) {
+      // Release the other workers before the pool rethrows.
+      is_done.store(true, std::memory_order_release);
+      throw;
+    }
+  });
+
+  statistics_ = Statistics();
+  statistics_.num_expanded = num_expanded.load();
+  statistics_.num_sent = num_sent.load();
+  for (const Worker& worker : workers) {
+    statistics_.num_generated += worker.num_generated;
+  }
+  if (is_aborted || idx_goal == kNone) return {};
+
+  std::vector<std::string> plan;
+  size_t idx_worker = idx_goal_worker;
+  size_t idx_node = idx_goal;
+  while (workers[idx_worker].nodes[idx_node].idx_parent != kNone) {
+    const Node& node = workers[idx_worker].nodes[idx_node];
+    plan.push_back(actions[node.id_action].to_string());
+    idx_worker = node.idx_parent_worker;
+    idx_node = node.idx_parent;
+  }
+  std::reverse(plan.begin(), plan.end());
+  return plan;
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "HashDistributedAStar") {
+  pddl.Ground();
+  const RelaxationHeuristic heuristic(pddl, RelaxationHeuristic::Type::kMax);
+  ThreadPool pool(4);
+  HashDistributedAStar search(
+      pddl,
+      [&heuristic](const StateIndex::IndexedState& s) { return heuristic(s); },
+      &pool);
+  const std::optional<std::vector<std::string>> plan =
+      search.Search(pddl.initial_state());
+  REQUIRE(plan.has_value());
+  REQUIRE(plan->size() == 5);
+  REQUIRE(pddl.IsValidPlan(*plan));
+  REQUIRE(search.statistics().num_expanded > 0);
+}
+
+TEST_CASE_FIXTURE(testing::DerivedFixture, "HashDistributedAStar.Derived") {
+  pddl.Ground();
+
+  // The relaxed task ignores derived predicates, so search without a
+  // heuristic.
+  ThreadPool pool(4);
+  HashDistributedAStar search(
+      pddl,
+      [](const StateIndex::IndexedState& /*state*/) { return size_t{0}; },
+      &pool);
+  const std::optional<std::vector<std::string>> plan =
+      search.Search(pddl.initial_state());
+  REQUIRE(plan.has_value());
+  REQUIRE(plan->size() == 6);
+  REQUIRE(pddl.IsValidPlan(*plan));
+}
+
+}  // namespace symbolic
@@ -0,0 +1,147 @@
+/**
+ * in_place_depth_first_search.cc
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#include "symbolic/planning/in_place_depth_first_search.h"
+
+#include <utility>  // std::move
+
+#include "utils/doctest.h"
+
+namespace {
+
+using ::symbolic::Object;
+
+/**
+ * Position of the next child to generate at one level of the search.
+ */
+struct Frame {
+  size_t idx_action = 0;
+  size_t idx_param = 0;
+};
+
+/**
+ * Action call applied at one level of the search.
+ */
+struct Step {
+  size_t idx_action;
+  std::vector<Object> arguments;
+};
+
+}  // namespace
+
+namespace symbolic {
+
+InPlaceDepthFirstSearch::InPlaceDepthFirstSearch(const Pddl& pddl,
+                                                 const State& state,
+                                                 size_t max_depth)
+    : pddl_(pddl),
+      root_(pddl.DerivedState(pddl.ConsistentState(state))),
+      max_depth_(max_depth) {}
+
+std::optional<std::vector<std::string>> InPlaceDepthFirstSearch::Search() {
+  num_generated_ = 0;
+  return Search(max_depth_);
+}
+
+std::optional<std::vector<std::string>>
+InPlaceDepthFirstSearch::SearchIterativeDeepening() {
+  num_generated_ = 0;
+  for (size_t depth = 0; depth <= max_depth_; depth++) {
+    std::optional<std::vector<std::string>> plan = Search(depth);
+    if (plan.has_value()) return plan;
+  }
+  return {};
+}
+
+std::optional<std::vector<std::string>> InPlaceDepthFirstSearch::Search(
+    size_t max_depth) {
+  const std::vector<Action>& actions = pddl_.actions();
+  state_ = root_;
+  log_.clear();
+  if (pddl_.goal()(state_)) return std::vector<std::string>();
+  if (max_depth == 0) return {};
+
+  std::vector<Frame> stack = {Frame()};
+  std::vector<Step> path;
+  while (!stack.empty()) {
+    // Generate the next child of the current node.
+    Frame& frame = stack.back();
+    bool is_expanded = false;
+    while (frame.idx_action < actions.size()) {
+      const Action& action = actions[frame.idx_action];
+      const ParameterGenerator& param_gen = action.parameter_generator();
+      const size_t num_params =
+          action.parameters().empty() ? 1 : param_gen.size();
+      if (frame.idx_param >= num_params) {
+        frame.idx_action++;
+        frame.idx_param = 0;
+        continue;
+      }
+
+      std::vector<Object> arguments;
+      if (!action.parameters().empty()) arguments = param_gen[frame.idx_param];
+      frame.idx_param++;
+      if (!action.IsValid(state_, arguments)) continue;
+
+      action.ApplyInPlace(arguments, &state_, &log_);
+      pddl_.UpdateDerivedPredicates(&state_, &log_);
+      num_generated_++;
+
+      // Skip children that return to a state on the current path.
+      if (log_.IsStateRepeated()) {
+        Action::Undo(&state_, &log_);
+        continue;
+      }
+
+      path.push_back({frame.idx_action, std::move(arguments)});
+      is_expanded = true;
+      break;
+    }
+
+    // Backtrack once all the children have been generated.
+    if (!is_expanded) {
+      stack.pop_back();
+      if (!path.empty()) {
+        Action::Undo(&state_, &log_);
+        path.pop_back();
+      }
+      continue;
+    }
+
+    if (pddl_.goal()(state_)) {
+      std::vector<std::string> plan;
+      plan.reserve(path.size());
+      for (const Step& step : path) {
+        plan.push_back(actions[step.idx_action].to_string(step.arguments));
+      }
+      return plan;
+    }
+
+    // Descend into the child, or undo it if the depth limit has been reached.
+    if (path.size() < max_depth) {
+      stack.emplace_back();
+    } else {
+      Action::Undo(&state_, &log_);
+      path.pop_back();
+    }
+  }
+  return {};
+}
+
+TEST_CASE_FIXTURE(testing::Fixture,
+                  "InPlaceDepthFirstSearch.SearchIterativeDeepening") {
+  InPlaceDepthFirstSearch dfs(pddl, pddl.initial_state(), 5);
+  const std::optional<std::vector<std::string>> plan =
+      dfs.SearchIterativeDeepening();
+  REQUIRE(plan.has_value());
+  REQUIRE(plan->size() == 5);
+  REQUIRE(pddl.IsValidPlan(*plan));
+}
+
+}  // namespace symbolic
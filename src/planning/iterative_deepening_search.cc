@@ -0,0 +1,190 @@
+/**
+ * iterative_deepening_search.cc
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#include "symbolic/planning/iterative_deepening_search.h"
+
+#include <algorithm>  // std::fill
+#include <exception>  // std::invalid_argument, std::runtime_error
+#include <utility>    // std::move, std::swap
+
+#include "utils/doctest.h"
+
+namespace {
+
+using ::symbolic::StateIndex;
+
+/**
+ * Node on the current path along with its remaining children.
+ */
+struct Frame {
+  StateIndex::IndexedState state;
+  std::vector<size_t> actions;
+  size_t idx_next = 0;
+};
+
+}  // namespace
+
+namespace symbolic {
+
+IterativeDeepeningSearch::IterativeDeepeningSearch(const Pddl& pddl,
+                                                   size_t table_size)
+    : pddl_(pddl), goal_(GroundAction::GroundGoal(pddl)) {
+  if (!pddl.is_grounded()) {
+    throw std::runtime_error(
+        "IterativeDeepeningSearch::IterativeDeepeningSearch(): Actions have "
+        "not been grounded.");
+  }
+  if (table_size < 2) {
+    throw std::invalid_argument(
+        "IterativeDeepeningSearch::IterativeDeepeningSearch(): Table size must "
+        "be at least 2.");
+  }
+
+  // Round down to a power of two so that buckets can be found with a mask.
+  size_t size = 2;
+  while (size <= table_size / 2) size *= 2;
+  table_.resize(size);
+}
+
+bool IterativeDeepeningSearch::Visit(uint64_t hash, uint64_t remaining) {
+  const size_t idx_bucket = 2 * (hash & (table_.size() / 2 - 1));
+  Entry& deep = table_[idx_bucket];
+  Entry& recent = table_[idx_bucket + 1];
+
+  for (Entry* entry : {&deep, &recent}) {
+    if (entry->remaining == Entry::kEmpty || entry->hash != hash) continue;
+    if (entry->remaining >= remaining) return false;
+    entry->remaining = remaining;
+    if (entry == &recent && remaining > deep.remaining) std::swap(deep, recent);
+    return true;
+  }
+
+  if (deep.remaining == Entry::kEmpty) {
+    deep = {hash, remaining};
+  } else if (remaining >= deep.remaining) {
+    recent = deep;
+    deep = {hash, remaining};
+  } else {
+    recent = {hash, remaining};
+  }
+  return true;
+}
+
+std::optional<std::vector<std::string>> IterativeDeepeningSearch::Search(
+    const State& state, size_t max_depth, size_t max_expansions,
+    std::chrono::microseconds us_timeout) {
+  const std::vector<GroundAction>& actions = pddl_.ground_actions();
+  const SuccessorGenerator& successor_generator = pddl_.successor_generator();
+
+  statistics_ = Statistics();
+  std::fill(table_.begin(), table_.end(), Entry());
+  const auto t_start = std::chrono::high_resolution_clock::now();
+
+  // Checks the budgets before each expansion.
+  const auto IsOverBudget = [this, max_expansions, us_timeout, &t_start]() {
+    if (max_expansions > 0 && statistics_.num_expanded >= max_expansions) {
+      return true;
+    }
+    return us_timeout.count() > 0 &&
+           std::chrono::high_resolution_clock::now() - t_start > us_timeout;
+  };
+
+  const StateIndex::IndexedState root = GroundAction::GetRoot(pddl_, state);
+  if (GroundAction::IsGoal(goal_, root)) return std::vector<std::string>();
+
+  std::vector<Frame> stack;
+  for (size_t depth_limit = 1; depth_limit <= max_depth; depth_limit++) {
+    statistics_.depth = depth_limit;
+    if (!Visit(StateIndex::IndexedStateHash{}(root), depth_limit)) continue;
+    if (IsOverBudget()) {
+      statistics_.is_aborted = true;
+      return {};
+    }
+    statistics_.num_expanded++;
+    stack.clear();
+    stack.push_back({root, successor_generator.GetApplicableActions(root)});
+
+    while (!stack.empty()) {
+      Frame& frame = stack.back();
+      if (frame.idx_next == frame.actions.size()) {
+        stack.pop_back();
+        continue;
+      }
+
+      // Generate the next child.
+      StateIndex::IndexedState next = frame.state;
+      actions[frame.actions[frame.idx_next++]].Apply(pddl_, &next);
+      statistics_.num_generated++;
+
+      if (GroundAction::IsGoal(goal_, next)) {
+        std::vector<std::string> plan;
+        plan.reserve(stack.size());
+        for (const Frame& f : stack) {
+          plan.push_back(actions[f.actions[f.idx_next - 1]].to_string());
+        }
+        return plan;
+      }
+
+      // Descend into the child unless the depth limit has been reached or it
+      // has already been expanded with as much remaining depth.
+      const size_t depth = stack.size();
+      if (depth == depth_limit) continue;
+      if (!Visit(StateIndex::IndexedStateHash{}(next), depth_limit - depth)) {
+        statistics_.num_pruned++;
+        continue;
+      }
+      if (IsOverBudget()) {
+        statistics_.is_aborted = true;
+        return {};
+      }
+      statistics_.num_expanded++;
+      std::vector<size_t> next_actions =
+          successor_generator.GetApplicableActions(next);
+      stack.push_back({std::move(next), std::move(next_actions)});
+    }
+  }
+  return {};
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "IterativeDeepeningSearch") {
+  pddl.Ground();
+  IterativeDeepeningSearch search(pddl);
+  const std::optional<std::vector<std::string>> plan =
+      search.Search(pddl.initial_state(), 8);
+  REQUIRE(plan.has_value());
+  REQUIRE(plan->size() == 5);
+  REQUIRE(pddl.IsValidPlan(*plan));
+  REQUIRE(search.statistics().depth == 5);
+  REQUIRE(!search.Search(pddl.initial_state(), 4).has_value());
+  REQUIRE(!search.statistics().is_aborted);
+
+  // A tiny table only costs duplicate work.
+  IterativeDeepeningSearch search_small(pddl, 3);
+  REQUIRE(search_small.table_size() == 2);
+  const std::optional<std::vector<std::string>> plan_small =
+      search_small.Search(pddl.initial_state(), 8);
+  REQUIRE(plan_small.has_value());
+  REQUIRE(plan_small->size() == 5);
+
+  REQUIRE(!search.Search(pddl.initial_state(), 8, 1).has_value());
+  REQUIRE(search.statistics().is_aborted);
+}
+
+TEST_CASE_FIXTURE(testing::DerivedFixture,
+                  "IterativeDeepeningSearch.Derived") {
+  pddl.Ground();
+  IterativeDeepeningSearch search(pddl);
+  const std::optional<std::vector<std::string>> plan =
+      search.Search(pddl.initial_state(), 8);
+  REQUIRE(plan.has_value());
+  REQUIRE(plan->size() == 6);
+  REQUIRE(pddl.IsValidPlan(*plan));
+}
+
+}  // namespace symbolic
@@ -0,0 +1,228 @@
+/**
+ * landmark_graph.cc
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#include "symbolic/planning/landmark_graph.h"
+
+#include <algorithm>  // std::binary_search, std::set_intersection, std::sort
+#include <iterator>   // std::back_inserter
+#include <optional>   // std::optional
+#include <queue>      // std::queue
+#include <utility>    // std::move
+
+#include "symbolic/planning/best_first_search.h"
+#include "symbolic/planning/relaxation_heuristic.h"
+#include "utils/doctest.h"
+
+namespace {
+
+using ::symbolic::GroundConjunction;
+using ::symbolic::RelaxedTask;
+using ::symbolic::StateIndex;
+
+// Sorted set of StateIndex indices.
+using Label = std::vector<size_t>;
+
+Label Union(const Label& a, const Label& b) {
+  Label c;
+  c.reserve(a.size() + b.size());
+  std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                 std::back_inserter(c));
+  return c;
+}
+
+/**
+ * Propagates the labels to a fixed point. Unreached propositions have no
+ * label.
+ */
+std::vector<std::optional<Label>> ComputeLabels(
+    const RelaxedTask& task, const StateIndex::IndexedState& state) {
+  const std::vector<RelaxedTask::Unit>& units = task.units();
+  const size_t num_props = task.num_propositions();
+  std::vector<std::optional<Label>> labels(num_props);
+  std::vector<size_t> num_unreached(units.size());
+  std::vector<bool> is_counted(num_props, false);
+  std::vector<bool> is_queued(num_props, false);
+  std::queue<size_t> queue;
+
+  // Intersects the label of the proposition with the new label, and queues
+  // the proposition if it changed.
+  const auto Update = [&](size_t idx_prop, Label&& label) {
+    std::optional<Label>& current = labels[idx_prop];
+    if (current.has_value()) {
+      Label intersection;
+      std::set_intersection(current->begin(), current->end(), label.begin(),
+                            label.end(), std::back_inserter(intersection));
+      if (intersection.size() == current->size()) return;
+      *current = std::move(intersection);
+    } else {
+      current = std::move(label);
+    }
+    if (is_queued[idx_prop]) return;
+    is_queued[idx_prop] = true;
+    queue.push(idx_prop);
+  };
+
+  const auto Fire = [&](size_t idx_unit) {
+    const RelaxedTask::Unit& unit = units[idx_unit];
+    Label label;
+    for (const size_t idx_pre : unit.pre) {
+      label = Union(label, *labels[idx_pre]);
+    }
+    for (const size_t idx_prop : unit.add) {
+      Update(idx_prop, Union(label, {idx_prop}));
+    }
+  };
+
+  for (size_t i = 0; i < num_props; i++) {
+    if (state[i]) {
+      Update(i, {i});
+    } else if (task.is_free(i)) {
+      Update(i, {});
+    }
+  }
+  for (size_t i = 0; i < units.size(); i++) {
+    num_unreached[i] = units[i].pre.size();
+    if (num_unreached[i] == 0) Fire(i);
+  }
+
+  while (!queue.empty()) {
+    const size_t idx_prop = queue.front();
+    queue.pop();
+    is_queued[idx_prop] = false;
+
+    // Units fire when their last precondition is reached, and again whenever
+    // the label of one of their preconditions shrinks.
+    const bool is_new = !is_counted[idx_prop];
+    is_counted[idx_prop] = true;
+    for (const size_t idx_unit : task.watchers(idx_prop)) {
+      if (is_new) num_unreached[idx_unit]--;
+      if (num_unreached[idx_unit] == 0) Fire(idx_unit);
+    }
+  }
+  return labels;
+}
+
+/**
+ * Returns the union of the labels of the positive goal literals, or nullopt if
+ * one of them is unreached.
+ */
+std::optional<Label> GoalLandmarks(
+    const std::vector<std::optional<Label>>& labels,
+    const GroundConjunction& goal) {
+  Label landmarks;
+  for (const size_t idx_prop : goal.pos) {
+    if (!labels[idx_prop].has_value()) return {};
+    landmarks = Union(landmarks, *labels[idx_prop]);
+  }
+  return landmarks;
+}
+
+}  // namespace
+
+namespace symbolic {
+
+LandmarkGraph::LandmarkGraph(const RelaxedTask& task,
+                             const StateIndex::IndexedState& state) {
+  const std::vector<std::optional<Label>> labels = ComputeLabels(task, state);
+
+  // Keep the landmarks shared by the reachable disjuncts of the goal.
+  for (const GroundConjunction& conj : task.goal()) {
+    std::optional<Label> landmarks = GoalLandmarks(labels, conj);
+    if (!landmarks.has_value()) continue;
+    if (!is_reachable_) {
+      landmarks_ = std::move(*landmarks);
+      is_reachable_ = true;
+      continue;
+    }
+    Label intersection;
+    std::set_intersection(landmarks_.begin(), landmarks_.end(),
+                          landmarks->begin(), landmarks->end(),
+                          std::back_inserter(intersection));
+    landmarks_ = std::move(intersection);
+  }
+
+  // Every landmark in the label of another must be reached before it.
+  for (const size_t idx_after : landmarks_) {
+    for (const size_t idx_before : *labels[idx_after]) {
+      if (idx_before == idx_after ||
+          !std::binary_search(landmarks_.begin(), landmarks_.end(),
+                              idx_before)) {
+        continue;
+      }
+      orderings_.emplace_back(idx_before, idx_after);
+    }
+  }
+  std::sort(orderings_.begin(), orderings_.end());
+}
+
+LandmarkGraph::LandmarkGraph(const Pddl& pddl, const State& state)
+    : LandmarkGraph(RelaxedTask(pddl),
+                    pddl.state_index().GetIndexedState(state)) {}
+
+size_t LandmarkCountHeuristic::operator()(const State& state) const {
+  return (*this)(pddl().state_index().GetIndexedState(state));
+}
+
+size_t LandmarkCountHeuristic::operator()(
+    const StateIndex::IndexedState& state) const {
+  const std::vector<std::optional<Label>> labels = ComputeLabels(task_, state);
+
+  size_t h = RelaxationHeuristic::kInfinity;
+  for (const GroundConjunction& conj : task_.goal()) {
+    const std::optional<Label> landmarks = GoalLandmarks(labels, conj);
+    if (!landmarks.has_value()) continue;
+    size_t num_false = 0;
+    for (const size_t idx_prop : *landmarks) {
+      if (!state[idx_prop]) num_false++;
+    }
+    h = std::min(h, num_false);
+  }
+  return h;
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "LandmarkGraph") {
+  pddl.Ground();
+  const StateIndex& state_index = pddl.state_index();
+  const auto Index = [&](const std::string& str_prop) {
+    return state_index.GetPropositionIndex(Proposition(pddl, str_prop));
+  };
+
+  // The box can only be reached by pushing it with the hook.
+  const LandmarkGraph graph(pddl, pddl.initial_state());
+  REQUIRE(graph.is_reachable());
+  const std::vector<size_t>& landmarks = graph.landmarks();
+  for (const char* str_prop : {"inhand(hook)", "inworkspace(box)",
+                               "inhand(box)", "on(box, shelf)"}) {
+    REQUIRE(std::binary_search(landmarks.begin(), landmarks.end(),
+                               Index(str_prop)));
+  }
+
+  const std::vector<LandmarkGraph::Ordering>& orderings = graph.orderings();
+  const auto HasOrdering = [&](const std::string& a, const std::string& b) {
+    return std::binary_search(orderings.begin(), orderings.end(),
+                              LandmarkGraph::Ordering(Index(a), Index(b)));
+  };
+  REQUIRE(HasOrdering("inhand(hook)", "inworkspace(box)"));
+  REQUIRE(HasOrdering("inworkspace(box)", "inhand(box)"));
+  REQUIRE(HasOrdering("inhand(box)", "on(box, shelf)"));
+
+  const LandmarkCountHeuristic heuristic(pddl);
+  REQUIRE(heuristic(pddl.initial_state()) == 4);
+
+  BestFirstSearch search(pddl,
+                         [&heuristic](const StateIndex::IndexedState& state) {
+                           return heuristic(state);
+                         });
+  const std::optional<std::vector<std::string>> plan =
+      search.Search(pddl.initial_state());
+  REQUIRE(plan.has_value());
+  REQUIRE(pddl.IsValidPlan(*plan));
+}
+
+}  // namespace symbolic
@@ -0,0 +1,216 @@
+/**
+ * parallel_breadth_first_search.cc
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#include "symbolic/planning/parallel_breadth_first_search.h"
+
+#include <algorithm>      // std::min, std::reverse, std::sort
+#include <exception>      // std::invalid_argument, std::runtime_error
+#include <limits>         // std::numeric_limits
+#include <tuple>          // std::tie
+#include <unordered_set>  // std::unordered_set
+#include <utility>        // std::move
+
+#include "utils/doctest.h"
+
+namespace {
+
+using ::symbolic::StateIndex;
+
+constexpr size_t kNoParent = std::numeric_limits<size_t>::max();
+constexpr size_t kNumShards = 64;
+
+using VisitedSet = std::unordered_set<StateIndex::IndexedState,
+                                      StateIndex::IndexedStateHash,
+                                      StateIndex::IndexedStateEqual>;
+
+struct Node {
+  size_t idx_parent;
+  size_t id_action;
+};
+
+struct Successor {
+  StateIndex::IndexedState state;
+  size_t idx_parent;
+  size_t id_action;
+  bool is_new = false;
+};
+
+// Successors of one frontier chunk, routed by visited set shard.
+using ChunkBuffer = std::vector<std::vector<Successor>>;
+
+size_t Shard(const StateIndex::IndexedState& state) {
+  return StateIndex::IndexedStateHash{}(state) % kNumShards;
+}
+
+}  // namespace
+
+namespace symbolic {
+
+ParallelBreadthFirstSearch::ParallelBreadthFirstSearch(const Pddl& pddl,
+                                                       ThreadPool* pool)
+    : pddl_(pddl), pool_(pool), goal_(GroundAction::GroundGoal(pddl)) {
+  if (!pddl.is_grounded()) {
+    throw std::runtime_error(
+        "ParallelBreadthFirstSearch::ParallelBreadthFirstSearch(): Actions "
+        "have not been grounded.");
+  }
+  if (pool == nullptr) {
+    throw std::invalid_argument(
+        "ParallelBreadthFirstSearch::ParallelBreadthFirstSearch(): Thread "
+        "pool is null.");
+  }
+}
+
+std::optional<std::vector<std::string>> ParallelBreadthFirstSearch::Search(
+    const State& state, size_t max_depth) {
+  const std::vector<GroundAction>& actions = pddl_.ground_actions();
+
+  statistics_ = Statistics();
+  std::vector<Node> nodes;
+  std::vector<VisitedSet> visited(kNumShards);
+
+  // Follows the parents from the node back to the root.
+  const auto GetPlan = [&nodes, &actions](size_t idx_node) {
+    std::vector<std::string> plan;
+    for (size_t idx = idx_node; nodes[idx].idx_parent != kNoParent;
+         idx = nodes[idx].idx_parent) {
+      plan.push_back(actions[nodes[idx].id_action].to_string());
+    }
+    std::reverse(plan.begin(), plan.end());
+    return plan;
+  };
+
+  // The frontier holds the states of nodes [idx_layer, nodes.size()).
+  std::vector<StateIndex::IndexedState> frontier = {
+      GroundAction::GetRoot(pddl_, state)};
+  size_t idx_layer = 0;
+  nodes.push_back({kNoParent, 0});
+  visited[Shard(frontier.front())].insert(frontier.front());
+  if (GroundAction::IsGoal(goal_, frontier.front())) return GetPlan(0);
+
+  while (!frontier.empty() &&
+         (max_depth == 0 || statistics_.depth < max_depth)) {
+    const size_t num_chunks =
+        std::min(frontier.size(), 4 * pool_->num_threads());
+    std::vector<ChunkBuffer> buffers(num_chunks, ChunkBuffer(kNumShards));
+
+    // Generate the successors of each chunk. The visited set is read-only.
+    std::vector<size_t> num_generated(num_chunks, 0);
+    pool_->Run(num_chunks, [&](size_t idx_chunk) {
+      const size_t idx_begin = idx_chunk * frontier.size() / num_chunks;
+      const size_t idx_end = (idx_chunk + 1) * frontier.size() / num_chunks;
+      ChunkBuffer& buffer = buffers[idx_chunk];
+      for (size_t i = idx_begin; i < idx_end; i++) {
+        const StateIndex::IndexedState& parent = frontier[i];
+        for (const size_t id_action :
+             pddl_.successor_generator().GetApplicableActions(parent)) {
+          StateIndex::IndexedState next = parent;
+          actions[id_action].Apply(pddl_, &next);
+          num_generated[idx_chunk]++;
+
+          const size_t idx_shard = Shard(next);
+          if (visited[idx_shard].count(next) > 0) continue;
+          buffer[idx_shard].push_back(
+              {std::move(next), idx_layer + i, id_action});
+        }
+      }
+    });
+
+    // Claim the new states shard by shard, visiting the chunks in frontier
+    // order so that the first parent wins.
+    pool_->Run(kNumShards, [&](size_t idx_shard) {
+      VisitedSet& shard = visited[idx_shard];
+      for (ChunkBuffer& buffer : buffers) {
+        for (Successor& successor : buffer[idx_shard]) {
+          successor.is_new = shard.insert(successor.state).second;
+        }
+      }
+    });
+
+    // Concatenate the claimed successors in chunk order.
+    std::vector<size_t> offsets(num_chunks + 1, 0);
+    for (size_t i = 0; i < num_chunks; i++) {
+      size_t num_new = 0;
+      for (const std::vector<Successor>& successors : buffers[i]) {
+        for (const Successor& successor : successors) {
+          num_new += successor.is_new;
+        }
+      }
+      offsets[i + 1] = offsets[i] + num_new;
+      statistics_.num_generated += num_generated[i];
+    }
+    statistics_.num_expanded += frontier.size();
+    statistics_.depth++;
+
+    idx_layer = nodes.size();
+    nodes.resize(idx_layer + offsets.back());
+    std::vector<StateIndex::IndexedState> next_frontier(offsets.back());
+    pool_->Run(num_chunks, [&](size_t idx_chunk) {
+      // Order the successors within the chunk by parent and action.
+      std::vector<Successor*> successors;
+      for (std::vector<Successor>& shard : buffers[idx_chunk]) {
+        for (Successor& successor : shard) {
+          if (successor.is_new) successors.push_back(&successor);
+        }
+      }
+      std::sort(successors.begin(), successors.end(),
+                [](const Successor* lhs, const Successor* rhs) {
+                  return std::tie(lhs->idx_parent, lhs->id_action) <
+                         std::tie(rhs->idx_parent, rhs->id_action);
+                });
+
+      size_t idx = offsets[idx_chunk];
+      for (Successor* successor : successors) {
+        nodes[idx_layer + idx] = {successor->idx_parent, successor->id_action};
+        next_frontier[idx] = std::move(successor->state);
+        idx++;
+      }
+    });
+    frontier = std::move(next_frontier);
+
+    for (size_t i = 0; i < frontier.size(); i++) {
+      if (GroundAction::IsGoal(goal_, frontier[i])) {
+        return GetPlan(idx_layer + i);
+      }
+    }
+  }
+  return {};
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "ParallelBreadthFirstSearch") {
+  pddl.Ground();
+  ThreadPool pool(4);
+  ParallelBreadthFirstSearch search(pddl, &pool);
+  const std::optional<std::vector<std::string>> plan =
+      search.Search(pddl.initial_state());
+  REQUIRE(plan.has_value());
+  REQUIRE(plan->size() == 5);
+  REQUIRE(pddl.IsValidPlan(*plan));
+  REQUIRE(search.statistics().depth == 5);
+  REQUIRE(!search.Search(pddl.initial_state(), 4).has_value());
+
+  // The plan doesn't depend on the number of threads.
+  ThreadPool pool_single(1);
+  ParallelBreadthFirstSearch search_single(pddl, &pool_single);
+  REQUIRE(search_single.Search(pddl.initial_state()) == plan);
+}
+
+TEST_CASE_FIXTURE(testing::DerivedFixture,
+                  "ParallelBreadthFirstSearch.Derived") {
+  pddl.Ground();
+  ThreadPool pool(4);
+  ParallelBreadthFirstSearch search(pddl, &pool);
+  const std::optional<std::vector<std::string>> plan =
+      search.Search(pddl.initial_state());
+  REQUIRE(plan.has_value());
+  REQUIRE(plan->size() == 6);
+  REQUIRE(pddl.IsValidPlan(*plan));
+}
+
+}  // namespace symbolic
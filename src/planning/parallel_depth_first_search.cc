@@ -0,0 +1,290 @@
+/**
+ * parallel_depth_first_search.cc
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#include "symbolic/planning/parallel_depth_first_search.h"
+
+#include <algorithm>      // std::min, std::reverse
+#include <atomic>         // std::atomic
+#include <chrono>         // std::chrono
+#include <deque>          // std::deque
+#include <exception>      // std::invalid_argument, std::runtime_error
+#include <memory>         // std::make_shared, std::shared_ptr
+#include <mutex>          // std::lock_guard, std::mutex
+#include <thread>         // std::this_thread
+#include <unordered_map>  // std::unordered_map
+#include <utility>        // std::move
+
+#include "utils/doctest.h"
+
+namespace {
+
+using ::symbolic::StateIndex;
+
+constexpr size_t kNumShards = 64;
+
+// Longest sleep of an idle worker between attempts to steal.
+constexpr std::chrono::microseconds kMaxBackoff(1000);
+
+// Link to the action that generated a node, shared by all of its descendants.
+struct PathNode {
+  std::shared_ptr<const PathNode> parent;
+  size_t id_action;
+};
+
+struct Task {
+  StateIndex::IndexedState state;
+  std::shared_ptr<const PathNode> path;
+  size_t depth;
+};
+
+// Deque of open nodes. The owner pushes and pops at the back, and thieves
+// steal from the front.
+struct Worker {
+  std::mutex mtx;
+  std::deque<Task> tasks;
+  size_t num_expanded = 0;
+  size_t num_generated = 0;
+  size_t num_stolen = 0;
+};
+
+// Shard of the transposition table, which maps states to the lowest depth at
+// which they have been reached.
+struct TableShard {
+  std::mutex mtx;
+  std::unordered_map<StateIndex::IndexedState, size_t,
+                     StateIndex::IndexedStateHash,
+                     StateIndex::IndexedStateEqual>
+      depths;
+};
+
+/**
+ * Records the state at the given depth.
+ *
+ * @returns True if the state hasn't been reached at this depth or shallower,
+ *          in which case it should be expanded.
+ */
+bool Claim(std::vector<TableShard>* table,
+           const StateIndex::IndexedState& state, size_t depth) {
+  TableShard& shard =
+      (*table)[StateIndex::IndexedStateHash{}(state) % kNumShards];
+  std::lock_guard<std::mutex> lock(shard.mtx);
+  const auto it = shard.depths.find(state);
+  if (it == shard.depths.end()) {
+    shard.depths.emplace(state, depth);
+    return true;
+  }
+  if (depth >= it->second) return false;
+  it->second = depth;
+  return true;
+}
+
+bool PopNewest(Worker* worker, Task* task) {
+  std::lock_guard<std::mutex> lock(worker->mtx);
+  if (worker->tasks.empty()) return false;
+  *task = std::move(worker->tasks.back());
+  worker->tasks.pop_back();
+  return true;
+}
+
+bool StealOldest(std::vector<Worker>* workers, size_t idx_thief, Task* task) {
+  const size_t num_workers = workers->size();
+  for (size_t i = 1; i < num_workers; i++) {
+    Worker& victim = (*workers)[(idx_thief + i) % num_workers];
+    std::lock_guard<std::mutex> lock(victim.mtx);
+    if (victim.tasks.empty()) continue;
+    *task = std::move(victim.tasks.front());
+    victim.tasks.pop_front();
+    return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+namespace symbolic {
+
+ParallelDepthFirstSearch::ParallelDepthFirstSearch(const Pddl& pddl,
+                                                   ThreadPool* pool)
+    : pddl_(pddl), pool_(pool), goal_(GroundAction::GroundGoal(pddl)) {
+  if (!pddl.is_grounded()) {
+    throw std::runtime_error(
+        "ParallelDepthFirstSearch::ParallelDepthFirstSearch(): Actions have "
+        "not been grounded.");
+  }
+  if (pool == nullptr) {
+    throw std::invalid_argument(
+        "ParallelDepthFirstSearch::ParallelDepthFirstSearch(): Thread pool is "
+        "null.");
+  }
+}
+
+std::optional<std::vector<std::string>> ParallelDepthFirstSearch::Search(
+    const State& state, size_t max_depth) {
+  statistics_ = Statistics();
+  return SearchDepthLimited(GroundAction::GetRoot(pddl_, state), max_depth);
+}
+
+std::optional<std::vector<std::string>>
+ParallelDepthFirstSearch::SearchIterativeDeepening(const State& state,
+                                                   size_t max_depth) {
+  statistics_ = Statistics();
+  const StateIndex::IndexedState root = GroundAction::GetRoot(pddl_, state);
+  for (size_t depth = 0; depth <= max_depth; depth++) {
+    std::optional<std::vector<std::string>> plan =
+        SearchDepthLimited(root, depth);
+    if (plan.has_value()) return plan;
+  }
+  return {};
+}
+
+std::optional<std::vector<std::string>>
+ParallelDepthFirstSearch::SearchDepthLimited(
+    const StateIndex::IndexedState& root, size_t max_depth) {
+  const std::vector<GroundAction>& actions = pddl_.ground_actions();
+
+  const size_t num_workers = pool_->num_threads();
+  std::vector<Worker> workers(num_workers);
+  std::vector<TableShard> table(kNumShards);
+
+  // Tasks that have been pushed but not finished expanding. Once it reaches
+  // zero, no more tasks can be pushed.
+  std::atomic<size_t> num_pending{1};
+  std::atomic<bool> is_done{false};
+
+  std::mutex mtx_plan;
+  bool is_found = false;
+  std::shared_ptr<const PathNode> path_plan;
+
+  Claim(&table, root, 0);
+  workers.front().tasks.push_back({root, nullptr, 0});
+
+  pool_->Run(num_workers, [&](size_t idx_worker) {
+    Worker& worker = workers[idx_worker];
+    std::vector<Task> children;
+    Task task;
+    std::chrono::microseconds backoff(0);
+    try {
+      while (!is_done.load(std::memory_order_acquire)) {
+        if (!PopNewest(&worker, &task)) {
+          if (!StealOldest(&workers, idx_worker, &task)) {
+            if (num_pending.load(std::memory_order_acquire) == 0) break;
+            if (backoff.count() == 0) {
+              std::this_thread::yield();
+              backoff = std::chrono::microseconds(1);
+            } else {
+              // Back off exponentially so that idle workers don't compete
+              // with busy ones for cores.
+              std::this_thread::sleep_for(backoff);
+              backoff = std::min(2 * backoff, kMaxBackoff);
+            }
+            continue;
+          }
+          worker.num_stolen++;
+        }
+        backoff = std::chrono::microseconds(0);
+
+        if (GroundAction::IsGoal(goal_, task.state)) {
+          std::lock_guard<std::mutex> lock(mtx_plan);
+          if (!is_found) {
+            is_found = true;
+            path_plan = std::move(task.path);
+          }
+          is_done.store(true, std::memory_order_release);
+          break;
+        }
+
+        worker.num_expanded++;
+        children.clear();
+        if (task.depth < max_depth) {
+          for (const size_t id_action :
+               pddl_.successor_generator().GetApplicableActions(task.state)) {
+            StateIndex::IndexedState next = task.state;
+            actions[id_action].Apply(pddl_, &next);
+            worker.num_generated++;
+
+            if (!Claim(&table, next, task.depth + 1)) continue;
+            std::shared_ptr<const PathNode> path =
+                std::make_shared<const PathNode>(
+                    PathNode{task.path, id_action});
+            children.push_back(
+                {std::move(next), std::move(path), task.depth + 1});
+          }
+        }
+
+        // Push the children in reverse so that the owner expands them in
+        // action order.
+        num_pending.fetch_add(children.size(), std::memory_order_acq_rel);
+        {
+          std::lock_guard<std::mutex> lock(worker.mtx);
+          for (auto it = children.rbegin(); it != children.rend(); ++it) {
+            worker.tasks.push_back(std::move(*it));
+          }
+        }
+        num_pending.fetch_sub(1, std::memory_order_acq_rel);
+      }
+    } catch (...) {
+      // Cancel the other workers before the pool rethrows.
+      is_done.store(true, std::memory_order_release);
+      throw;
+    }
+  });
+
+  for (const Worker& worker : workers) {
+    statistics_.num_expanded += worker.num_expanded;
+    statistics_.num_generated += worker.num_generated;
+    statistics_.num_stolen += worker.num_stolen;
+  }
+  if (!is_found) return {};
+
+  std::vector<std::string> plan;
+  for (const PathNode* node = path_plan.get(); node != nullptr;
+       node = node->parent.get()) {
+    plan.push_back(actions[node->id_action].to_string());
+  }
+  std::reverse(plan.begin(), plan.end());
+  return plan;
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "ParallelDepthFirstSearch") {
+  pddl.Ground();
+  ThreadPool pool(4);
+  ParallelDepthFirstSearch search(pddl, &pool);
+  const std::optional<std::vector<std::string>> plan =
+      search.Search(pddl.initial_state(), 8);
+  REQUIRE(plan.has_value());
+  REQUIRE(plan->size() <= 8);
+  REQUIRE(pddl.IsValidPlan(*plan));
+  REQUIRE(!search.Search(pddl.initial_state(), 4).has_value());
+
+  const std::optional<std::vector<std::string>> plan_shortest =
+      search.SearchIterativeDeepening(pddl.initial_state(), 8);
+  REQUIRE(plan_shortest.has_value());
+  REQUIRE(plan_shortest->size() == 5);
+  REQUIRE(pddl.IsValidPlan(*plan_shortest));
+}
+
+TEST_CASE_FIXTURE(testing::DerivedFixture,
+                  "ParallelDepthFirstSearch.Derived") {
+  pddl.Ground();
+  ThreadPool pool(4);
+  ParallelDepthFirstSearch search(pddl, &pool);
+  const std::optional<std::vector<std::string>> plan =
+      search.Search(pddl.initial_state(), 8);
+  REQUIRE(plan.has_value());
+  REQUIRE(plan->size() <= 8);
+  REQUIRE(pddl.IsValidPlan(*plan));
+
+  const std::optional<std::vector<std::string>> plan_shortest =
+      search.SearchIterativeDeepening(pddl.initial_state(), 8);
+  REQUIRE(plan_shortest.has_value());
+  REQUIRE(plan_shortest->size() == 6);
+  REQUIRE(pddl.IsValidPlan(*plan_shortest));
+}
+
+}  // namespace symbolic
@@ -0,0 +1,603 @@
+/**
+ * pattern_database.cc
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#include "symbolic/planning/pattern_database.h"
+
+#include <algorithm>   // std::is_sorted, std::max, std::min, std::sort
+#include <cstdio>      // std::remove
+#include <exception>   // std::invalid_argument, std::runtime_error
+#include <filesystem>  // std::filesystem
+#include <fstream>     // std::ifstream, std::ofstream
+#include <iterator>    // std::istreambuf_iterator
+#include <string>      // std::getline, std::to_string
+#include <tuple>       // std::tie
+#include <utility>     // std::pair
+
+#include "symbolic/planning/a_star.h"
+#include "symbolic/planning/best_first_search.h"
+#include "symbolic/planning/planner.h"
+#include "symbolic/planning/relaxation_heuristic.h"
+#include "symbolic/planning/relaxed_task.h"
+#include "utils/doctest.h"
+
+namespace {
+
+using ::symbolic::GroundAction;
+using ::symbolic::GroundConditionalEffect;
+using ::symbolic::GroundConjunction;
+using ::symbolic::PatternDatabase;
+using ::symbolic::Pddl;
+
+// Bit i is the value of the i-th pattern proposition.
+using AbstractState = uint32_t;
+
+constexpr char kFileHeader[] = "symbolic_pattern_database 2";
+constexpr uint8_t kMaxDistance = PatternDatabase::kUnreachable - 1;
+
+/**
+ * Projected action that requires the pre bits to have the given values, and
+ * sets the effect bits to the given values.
+ */
+struct AbstractOperator {
+  AbstractState pre_mask = 0;
+  AbstractState pre_val = 0;
+  AbstractState eff_mask = 0;
+  AbstractState eff_val = 0;
+
+  bool operator<(const AbstractOperator& other) const {
+    return std::tie(pre_mask, pre_val, eff_mask, eff_val) <
+           std::tie(other.pre_mask, other.pre_val, other.eff_mask,
+                    other.eff_val);
+  }
+
+  bool operator==(const AbstractOperator& other) const {
+    return pre_mask == other.pre_mask && pre_val == other.pre_val &&
+           eff_mask == other.eff_mask && eff_val == other.eff_val;
+  }
+};
+
+/**
+ * Adds the projected literals to the partial assignment.
+ *
+ * @param bits Pattern bit of each StateIndex proposition, or -1.
+ * @returns False if the literals contradict the assignment.
+ */
+bool AddLiterals(const std::vector<size_t>& props, bool value,
+                 const std::vector<int>& bits, AbstractState* mask,
+                 AbstractState* val) {
+  for (const size_t idx_prop : props) {
+    if (bits[idx_prop] < 0) continue;
+    const AbstractState bit = AbstractState(1) << bits[idx_prop];
+    if (*mask & bit) {
+      if (static_cast<bool>(*val & bit) != value) return false;
+      continue;
+    }
+    *mask |= bit;
+    if (value) *val |= bit;
+  }
+  return true;
+}
+
+AbstractState Project(const std::vector<size_t>& props,
+                      const std::vector<int>& bits) {
+  AbstractState mask = 0;
+  for (const size_t idx_prop : props) {
+    if (bits[idx_prop] >= 0) mask |= AbstractState(1) << bits[idx_prop];
+  }
+  return mask;
+}
+
+/**
+ * Calls the function on every abstract state that extends the base with a
+ * subset of the free bits.
+ */
+template <typename Function>
+void ForEachSubset(AbstractState base, AbstractState free, Function&& f) {
+  AbstractState subset = free;
+  while (true) {
+    f(base | subset);
+    if (subset == 0) break;
+    subset = (subset - 1) & free;
+  }
+}
+
+/**
+ * Projects the action, with one operator for each subset of its relevant
+ * conditional effects that fires.
+ *
+ * If the effects of the action are order dependent, its conditions may be
+ * evaluated in a partly modified state, so they are dropped, and propositions
+ * written both ways may end up with either value. This over-approximates the
+ * transitions, which keeps the distances admissible.
+ */
+void ProjectAction(const GroundAction& action, const std::vector<int>& bits,
+                   std::vector<AbstractOperator>* ops) {
+  AbstractOperator base;
+  if (!AddLiterals(action.pre_pos(), true, bits, &base.pre_mask,
+                   &base.pre_val) ||
+      !AddLiterals(action.pre_neg(), false, bits, &base.pre_mask,
+                   &base.pre_val)) {
+    return;
+  }
+
+  std::vector<const GroundConditionalEffect*> effects;
+  for (const GroundConditionalEffect& effect : action.conditional_effects()) {
+    if (Project(effect.add_effects, bits) == 0 &&
+        Project(effect.del_effects, bits) == 0) {
+      continue;
+    }
+    effects.push_back(&effect);
+  }
+  if (effects.size() >= 16) {
+    throw std::runtime_error(
+        "PatternDatabase::PatternDatabase(): Too many conditional effects in "
+        "the pattern for action " +
+        action.to_string() + ".");
+  }
+
+  // Unconditional adds and deletes are disjoint.
+  const AbstractState del_base = Project(action.del_effects(), bits);
+  const AbstractState add_base = Project(action.add_effects(), bits);
+  for (size_t fired = 0; fired < (size_t(1) << effects.size()); fired++) {
+    AbstractOperator op = base;
+    AbstractState del = del_base;
+    AbstractState add = add_base;
+    bool is_consistent = true;
+    for (size_t i = 0; i < effects.size() && is_consistent; i++) {
+      if (!(fired & (size_t(1) << i))) continue;
+      const GroundConditionalEffect& effect = *effects[i];
+      if (!action.is_order_dependent()) {
+        is_consistent =
+            AddLiterals(effect.pre_pos, true, bits, &op.pre_mask,
+                        &op.pre_val) &&
+            AddLiterals(effect.pre_neg, false, bits, &op.pre_mask, &op.pre_val);
+      }
+      del |= Project(effect.del_effects, bits);
+      add |= Project(effect.add_effects, bits);
+    }
+    if (!is_consistent) continue;
+
+    op.eff_mask = del | add;
+    if (op.eff_mask == 0) continue;
+    const AbstractState conflict = del & add;
+    ForEachSubset(add & ~conflict, conflict, [&op, ops](AbstractState val) {
+      op.eff_val = val;
+      ops->push_back(op);
+    });
+  }
+}
+
+std::vector<int> GetPatternBits(const Pddl& pddl,
+                                const std::vector<size_t>& pattern) {
+  std::vector<int> bits(pddl.state_index().size(), -1);
+  for (size_t i = 0; i < pattern.size(); i++) {
+    bits[pattern[i]] = static_cast<int>(i);
+  }
+  return bits;
+}
+
+/**
+ * Projects the ground actions, which often collapse onto the same operator.
+ *
+ * @returns Sorted unique operators.
+ */
+std::vector<AbstractOperator> ProjectActions(const Pddl& pddl,
+                                             const std::vector<int>& bits) {
+  std::vector<AbstractOperator> ops;
+  for (const GroundAction& action : pddl.ground_actions()) {
+    ProjectAction(action, bits, &ops);
+  }
+  std::sort(ops.begin(), ops.end());
+  ops.erase(std::unique(ops.begin(), ops.end()), ops.end());
+  return ops;
+}
+
+/**
+ * Projects the goal conjunctions that are consistent in the abstraction.
+ *
+ * @returns Mask and value of the bits required by each conjunction.
+ */
+std::vector<std::pair<AbstractState, AbstractState>> ProjectGoal(
+    const Pddl& pddl, const std::vector<int>& bits) {
+  std::vector<std::pair<AbstractState, AbstractState>> goal;
+  for (const GroundConjunction& conj : GroundAction::GroundGoal(pddl)) {
+    AbstractState mask = 0;
+    AbstractState val = 0;
+    if (!AddLiterals(conj.pos, true, bits, &mask, &val) ||
+        !AddLiterals(conj.neg, false, bits, &mask, &val)) {
+      continue;
+    }
+    goal.emplace_back(mask, val);
+  }
+  return goal;
+}
+
+/**
+ * 64-bit FNV-1a hash, which unlike std::hash is the same for every standard
+ * library and platform, so it can be saved to disk.
+ */
+class Fingerprint {
+ public:
+  void Add(uint64_t value) {
+    for (size_t i = 0; i < sizeof(value); i++) {
+      hash_ = (hash_ ^ ((value >> (8 * i)) & 0xff)) * kPrime;
+    }
+  }
+
+  void Add(const std::string& str) {
+    Add(str.size());
+    for (const char c : str) {
+      hash_ = (hash_ ^ static_cast<uint8_t>(c)) * kPrime;
+    }
+  }
+
+  uint64_t value() const { return hash_; }
+
+ private:
+  static constexpr uint64_t kOffset = 14695981039346656037ULL;
+  static constexpr uint64_t kPrime = 1099511628211ULL;
+
+  uint64_t hash_ = kOffset;
+};
+
+/**
+ * Fingerprints everything that determines the distance table: the domain,
+ * the pattern propositions, and the projected goal and actions, which depend
+ * on the objects and static facts of the problem.
+ */
+uint64_t ComputeFingerprint(
+    const Pddl& pddl, const std::vector<size_t>& pattern,
+    const std::vector<AbstractOperator>& ops,
+    const std::vector<std::pair<AbstractState, AbstractState>>& goal) {
+  Fingerprint fingerprint;
+  fingerprint.Add(pddl.name());
+  fingerprint.Add(pattern.size());
+  for (const size_t idx_prop : pattern) {
+    fingerprint.Add(pddl.state_index().GetProposition(idx_prop).to_string());
+  }
+  fingerprint.Add(goal.size());
+  for (const std::pair<AbstractState, AbstractState>& conj : goal) {
+    fingerprint.Add(conj.first);
+    fingerprint.Add(conj.second);
+  }
+  fingerprint.Add(ops.size());
+  for (const AbstractOperator& op : ops) {
+    fingerprint.Add(op.pre_mask);
+    fingerprint.Add(op.pre_val);
+    fingerprint.Add(op.eff_mask);
+    fingerprint.Add(op.eff_val);
+  }
+  return fingerprint.value();
+}
+
+}  // namespace
+
+namespace symbolic {
+
+PatternDatabase::PatternDatabase(const Pddl& pddl,
+                                 const std::vector<size_t>& pattern)
+    : pddl_(&pddl) {
+  // The relaxed task determines which propositions are uncontrolled.
+  const RelaxedTask task(pddl);
+  for (const size_t idx_prop : pattern) {
+    if (idx_prop >= task.num_propositions()) {
+      throw std::invalid_argument(
+          "PatternDatabase::PatternDatabase(): Proposition index " +
+          std::to_string(idx_prop) + " is out of range.");
+    }
+    if (!task.is_free(idx_prop)) pattern_.push_back(idx_prop);
+  }
+  std::sort(pattern_.begin(), pattern_.end());
+  pattern_.erase(std::unique(pattern_.begin(), pattern_.end()),
+                 pattern_.end());
+  if (pattern_.size() > kMaxPatternSize) {
+    throw std::invalid_argument(
+        "PatternDatabase::PatternDatabase(): Pattern has " +
+        std::to_string(pattern_.size()) + " propositions but the maximum is " +
+        std::to_string(kMaxPatternSize) + ".");
+  }
+
+  const std::vector<int> bits = GetPatternBits(pddl, pattern_);
+  const std::vector<AbstractOperator> ops = ProjectActions(pddl, bits);
+  const std::vector<std::pair<AbstractState, AbstractState>> goal =
+      ProjectGoal(pddl, bits);
+  fingerprint_ = ComputeFingerprint(pddl, pattern_, ops, goal);
+
+  const AbstractState num_states = AbstractState(1) << pattern_.size();
+  const AbstractState all = num_states - 1;
+  distances_.assign(num_states, kUnreachable);
+  std::vector<AbstractState> queue;
+  const auto Visit = [this, &queue](AbstractState s, uint8_t distance) {
+    if (distances_[s] != kUnreachable) return;
+    distances_[s] = distance;
+    queue.push_back(s);
+  };
+
+  // Seed the search with the abstract states that satisfy the goal.
+  for (const auto& [mask, val] : goal) {
+    ForEachSubset(val, all & ~mask, [&Visit](AbstractState s) { Visit(s, 0); });
+  }
+
+  // Backward breadth-first search by regressing the operators.
+  for (size_t i = 0; i < queue.size(); i++) {
+    const AbstractState next = queue[i];
+    const uint8_t distance =
+        std::min<uint8_t>(distances_[next] + 1, kMaxDistance);
+    for (const AbstractOperator& op : ops) {
+      if ((next & op.eff_mask) != op.eff_val) continue;
+
+      // Bits outside of the effects are unchanged, so they must already
+      // satisfy the preconditions.
+      const AbstractState unchanged = next & ~op.eff_mask;
+      const AbstractState pre_unchanged = op.pre_mask & ~op.eff_mask;
+      if ((unchanged & pre_unchanged) != (op.pre_val & pre_unchanged)) {
+        continue;
+      }
+      const AbstractState base = unchanged | (op.pre_val & op.eff_mask);
+      const AbstractState free = op.eff_mask & ~op.pre_mask;
+      ForEachSubset(base, free, [&Visit, distance](AbstractState s) {
+        Visit(s, distance);
+      });
+    }
+  }
+}
+
+std::vector<size_t> PatternDatabase::CreatePattern(
+    const Pddl& pddl, const std::vector<std::string>& atoms) {
+  const StateIndex& state_index = pddl.state_index();
+  std::vector<size_t> pattern;
+  for (const std::string& atom : atoms) {
+    if (atom.find('(') != std::string::npos) {
+      pattern.push_back(
+          state_index.GetPropositionIndex(Proposition(pddl, atom)));
+      continue;
+    }
+
+    const size_t num_props = pattern.size();
+    for (size_t i = 0; i < state_index.size(); i++) {
+      if (state_index.GetProposition(i).name() == atom) pattern.push_back(i);
+    }
+    if (pattern.size() == num_props) {
+      throw std::invalid_argument(
+          "PatternDatabase::CreatePattern(): Predicate " + atom +
+          " has no propositions.");
+    }
+  }
+  std::sort(pattern.begin(), pattern.end());
+  pattern.erase(std::unique(pattern.begin(), pattern.end()), pattern.end());
+  return pattern;
+}
+
+void PatternDatabase::Save(const std::string& filename) const {
+  std::ofstream file(filename, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("PatternDatabase::Save(): Unable to open " +
+                             filename + ".");
+  }
+  const StateIndex& state_index = pddl_->state_index();
+  file << kFileHeader << std::endl;
+  file << fingerprint_ << std::endl;
+  file << pattern_.size() << std::endl;
+  for (const size_t idx_prop : pattern_) {
+    file << state_index.GetProposition(idx_prop).to_string() << std::endl;
+  }
+  file.write(reinterpret_cast<const char*>(distances_.data()),
+             distances_.size());
+  if (!file) {
+    throw std::runtime_error("PatternDatabase::Save(): Unable to write " +
+                             filename + ".");
+  }
+}
+
+PatternDatabase PatternDatabase::Load(const Pddl& pddl,
+                                      const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("PatternDatabase::Load(): Unable to open " +
+                             filename + ".");
+  }
+
+  std::string line;
+  if (!std::getline(file, line) || line != kFileHeader) {
+    throw std::runtime_error("PatternDatabase::Load(): " + filename +
+                             " is not a pattern database.");
+  }
+  uint64_t fingerprint = 0;
+  size_t num_props = 0;
+  file >> fingerprint >> num_props;
+  std::getline(file, line);
+  if (!file || num_props > kMaxPatternSize) {
+    throw std::runtime_error("PatternDatabase::Load(): " + filename +
+                             " has an invalid header.");
+  }
+
+  const StateIndex& state_index = pddl.state_index();
+  std::vector<size_t> pattern;
+  pattern.reserve(num_props);
+  for (size_t i = 0; i < num_props; i++) {
+    std::getline(file, line);
+    pattern.push_back(state_index.GetPropositionIndex(Proposition(pddl, line)));
+  }
+  if (!std::is_sorted(pattern.begin(), pattern.end())) {
+    throw std::runtime_error("PatternDatabase::Load(): " + filename +
+                             " was built for a different state index.");
+  }
+
+  // The distances are only valid for the same abstraction.
+  const std::vector<int> bits = GetPatternBits(pddl, pattern);
+  if (fingerprint != ComputeFingerprint(pddl, pattern,
+                                        ProjectActions(pddl, bits),
+                                        ProjectGoal(pddl, bits))) {
+    throw std::runtime_error("PatternDatabase::Load(): " + filename +
+                             " was built for a different problem.");
+  }
+
+  std::vector<uint8_t> distances(size_t(1) << num_props);
+  file.read(reinterpret_cast<char*>(distances.data()), distances.size());
+  if (!file) {
+    throw std::runtime_error("PatternDatabase::Load(): " + filename +
+                             " is truncated.");
+  }
+  return PatternDatabase(pddl, std::move(pattern), std::move(distances),
+                         fingerprint);
+}
+
+size_t PatternDatabase::operator()(const State& state) const {
+  return (*this)(pddl_->state_index().GetIndexedState(state));
+}
+
+size_t PatternDatabase::operator()(
+    const StateIndex::IndexedState& state) const {
+  AbstractState s = 0;
+  for (size_t i = 0; i < pattern_.size(); i++) {
+    if (state[pattern_[i]]) s |= AbstractState(1) << i;
+  }
+  const uint8_t distance = distances_[s];
+  return distance == kUnreachable ? RelaxationHeuristic::kInfinity : distance;
+}
+
+PatternDatabaseHeuristic::PatternDatabaseHeuristic(
+    std::vector<PatternDatabase> pdbs, Combination combination)
+    : pdbs_(std::move(pdbs)), combination_(combination) {
+  if (pdbs_.empty()) {
+    throw std::invalid_argument(
+        "PatternDatabaseHeuristic::PatternDatabaseHeuristic(): No pattern "
+        "databases.");
+  }
+  const Pddl& pddl = pdbs_.front().pddl();
+  for (const PatternDatabase& pdb : pdbs_) {
+    if (&pdb.pddl() != &pddl) {
+      throw std::invalid_argument(
+          "PatternDatabaseHeuristic::PatternDatabaseHeuristic(): Pattern "
+          "databases must be built for the same Pddl.");
+    }
+  }
+  if (combination_ != Combination::kSum) return;
+
+  // Check that the patterns are additive.
+  std::vector<std::vector<size_t>> owners(pddl.state_index().size());
+  for (size_t i = 0; i < pdbs_.size(); i++) {
+    for (const size_t idx_prop : pdbs_[i].pattern()) {
+      owners[idx_prop].push_back(i);
+    }
+  }
+  for (const GroundAction& action : pddl.ground_actions()) {
+    std::vector<size_t> affected;
+    const auto Affect = [&owners, &affected](const std::vector<size_t>& props) {
+      for (const size_t idx_prop : props) {
+        affected.insert(affected.end(), owners[idx_prop].begin(),
+                        owners[idx_prop].end());
+      }
+    };
+    Affect(action.add_effects());
+    Affect(action.del_effects());
+    for (const GroundConditionalEffect& effect : action.conditional_effects()) {
+      Affect(effect.add_effects);
+      Affect(effect.del_effects);
+    }
+    std::sort(affected.begin(), affected.end());
+    if (std::unique(affected.begin(), affected.end()) - affected.begin() > 1) {
+      throw std::invalid_argument(
+          "PatternDatabaseHeuristic::PatternDatabaseHeuristic(): Patterns are "
+          "not additive since " +
+          action.to_string() + " affects more than one of them.");
+    }
+  }
+}
+
+size_t PatternDatabaseHeuristic::operator()(const State& state) const {
+  return (*this)(pddl().state_index().GetIndexedState(state));
+}
+
+size_t PatternDatabaseHeuristic::operator()(
+    const StateIndex::IndexedState& state) const {
+  size_t h = 0;
+  for (const PatternDatabase& pdb : pdbs_) {
+    const size_t h_pdb = pdb(state);
+    if (h_pdb == RelaxationHeuristic::kInfinity) return h_pdb;
+    h = combination_ == Combination::kSum ? h + h_pdb : std::max(h, h_pdb);
+  }
+  return h;
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "PatternDatabase") {
+  pddl.Ground();
+  const State& state = pddl.initial_state();
+
+  // The box must be picked and placed on the shelf.
+  const PatternDatabase pdb(
+      pddl, PatternDatabase::CreatePattern(pddl, {"inhand", "on(box, shelf)"}));
+  REQUIRE(pdb.pattern().size() == 3);
+  REQUIRE(pdb(state) == 2);
+
+  // Both patterns are affected by place(box, shelf).
+  const PatternDatabase pdb_inhand(
+      pddl, PatternDatabase::CreatePattern(pddl, {"inhand"}));
+  const PatternDatabase pdb_on(
+      pddl, PatternDatabase::CreatePattern(pddl, {"on(box, shelf)"}));
+  REQUIRE_THROWS((PatternDatabaseHeuristic(
+      {pdb_inhand, pdb_on}, PatternDatabaseHeuristic::Combination::kSum)));
+
+  const std::string filename =
+      (std::filesystem::temp_directory_path() / "symbolic_test.pdb").string();
+  pdb.Save(filename);
+  const PatternDatabase loaded = PatternDatabase::Load(pddl, filename);
+  REQUIRE(loaded.pattern() == pdb.pattern());
+  REQUIRE(loaded.distances() == pdb.distances());
+
+  // Files whose fingerprint doesn't match the problem are rejected.
+  std::string contents;
+  {
+    std::ifstream file(filename, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(file),
+                    std::istreambuf_iterator<char>());
+  }
+  const size_t idx_fingerprint = contents.find('\n') + 1;
+  contents[idx_fingerprint] = contents[idx_fingerprint] == '1' ? '2' : '1';
+  {
+    std::ofstream file(filename, std::ios::binary);
+    file << contents;
+  }
+  REQUIRE_THROWS(PatternDatabase::Load(pddl, filename));
+  std::remove(filename.c_str());
+
+  // The pattern of all the predicates gives the exact distance.
+  const PatternDatabaseHeuristic heuristic(
+      {pdb, PatternDatabase(pddl, PatternDatabase::CreatePattern(
+                                      pddl, {"inhand", "on", "inworkspace"}))},
+      PatternDatabaseHeuristic::Combination::kMax);
+  REQUIRE(heuristic(state) == 5);
+
+  BestFirstSearch search(pddl,
+                         [&heuristic](const StateIndex::IndexedState& s) {
+                           return heuristic(s);
+                         });
+  const std::optional<std::vector<std::string>> plan = search.Search(state);
+  REQUIRE(plan.has_value());
+  REQUIRE(plan->size() == 5);
+
+  // The heuristic also orders the Planner nodes in AStar.
+  using Node = HeuristicNode<Planner::Node, PatternDatabaseHeuristic>;
+  const Planner planner(pddl);
+  const Node root(planner.root(), heuristic);
+  REQUIRE(root.h() == 5);
+  const HeuristicCompare<Node> compare;
+  AStar<Node, HeuristicCompare<Node>> astar(compare, root, 8);
+  const auto it = astar.begin();
+  REQUIRE(it != astar.end());
+  const std::vector<Node>& nodes = *it;
+  REQUIRE(nodes.size() == 6);
+  std::vector<std::string> plan_astar;
+  for (auto it_node = nodes.begin() + 1; it_node != nodes.end(); ++it_node) {
+    plan_astar.push_back(it_node->node().action());
+  }
+  REQUIRE(pddl.IsValidPlan(plan_astar));
+}
+
+}  // namespace symbolic
@@ -17,6 +17,9 @@
 #include <unordered_set>  // std::unordered_set
 #endif                    // SYMBOLIC_PLANNER_USE_ORDERED_CACHE
 
+#include "symbolic/planning/breadth_first_search.h"
+#include "utils/doctest.h"
+
 namespace symbolic {
 
 struct Planner::Node::NodeImpl {
@@ -26,47 +29,72 @@ struct Planner::Node::NodeImpl {
   using Cache = std::unordered_set<Node>;
 #endif  // SYMBOLIC_PLANNER_USE_ORDERED_CACHE
 
+  using ClosedList = std::unordered_set<State>;
+
   NodeImpl(const Pddl& pddl, State&& state,
-           const std::shared_ptr<const Cache>& ancestors, std::string&& action,
+           const std::shared_ptr<const Cache>& ancestors,
+           const std::shared_ptr<ClosedList>& closed, std::string&& action,
            size_t depth)
       : pddl_(pddl),
         state_(std::move(state)),
         ancestors_(ancestors),
+        closed_(closed),
         action_(std::move(action)),
         depth_(depth) {}
 
-  NodeImpl(const Pddl& pddl, const State& state, size_t depth = 0)
+  // Children update the derived predicates incrementally, so the root state
+  // needs them to be up to date.
+  NodeImpl(const Pddl& pddl, const State& state, size_t depth,
+           DuplicateDetection duplicate_detection)
       : pddl_(pddl),
-        state_(state),
+        state_(pddl.DerivedState(state)),
         ancestors_(std::make_shared<const Cache>()),
+        closed_(duplicate_detection == DuplicateDetection::kGlobal
+                    ? std::make_shared<ClosedList>()
+                    : nullptr),
         depth_(depth) {}
 
   const Pddl& pddl_;
 
   const State state_;
+
+  // Ancestors on the path from the root, which stay empty with a global
+  // closed list.
   const std::shared_ptr<const Cache> ancestors_;
 
+  // States expanded by the whole search, or null for path duplicates.
+  const std::shared_ptr<ClosedList> closed_;
+
+  // Whether this node closed its state in the global closed list.
+  bool is_expanded_ = false;
+
   // For debugging
   const std::string action_;
   const size_t depth_;
 };
 
-Planner::Node::Node(const Pddl& pddl, const State& state, size_t depth)
-    : impl_(std::make_shared<NodeImpl>(pddl, state, depth)) {}
+Planner::Node::Node(const Pddl& pddl, const State& state, size_t depth,
+                    DuplicateDetection duplicate_detection)
+    : impl_(std::make_shared<NodeImpl>(pddl, state, depth,
+                                       duplicate_detection)) {}
 
 Planner::Node::Node(const Node& parent, const Node& sibling, State&& state,
                     std::string&& action) {
   if (!sibling.impl_) {
-    auto ancestors =
-        std::make_shared<Planner::Node::NodeImpl::Cache>(*parent->ancestors_);
-    ancestors->insert(parent);
+    // The closed list replaces the ancestors, so they don't need to be copied.
+    std::shared_ptr<const NodeImpl::Cache> ancestors = parent->ancestors_;
+    if (!parent->closed_) {
+      auto path = std::make_shared<NodeImpl::Cache>(*parent->ancestors_);
+      path->insert(parent);
+      ancestors = std::move(path);
+    }
     impl_ = std::make_shared<NodeImpl>(parent->pddl_, std::move(state),
-                                       std::move(ancestors), std::move(action),
-                                       parent.depth() + 1);
+                                       ancestors, parent->closed_,
+                                       std::move(action), parent.depth() + 1);
   } else {
     impl_ = std::make_shared<NodeImpl>(sibling->pddl_, std::move(state),
-                                       sibling->ancestors_, std::move(action),
-                                       sibling.depth());
+                                       sibling->ancestors_, sibling->closed_,
+                                       std::move(action), sibling.depth());
   }
 }
 
@@ -77,8 +105,25 @@ const State& Planner::Node::state() const { return impl_->state_; }
 size_t Planner::Node::depth() const { return impl_->depth_; }
 
 Planner::Node::iterator Planner::Node::begin() const {
+  // Only the first node expanded with a state generates its children.
+  if (impl_->closed_ && !impl_->is_expanded_) {
+    if (!impl_->closed_->insert(impl_->state_).second) return end();
+    impl_->is_expanded_ = true;
+  }
+
   iterator it(*this);
-  if (it == end()) return it;
+  if (it.it_action_ == impl_->pddl_.actions().end()) return it;
+
+  if (it.is_grounded_) {
+    // Only begin() lists the applicable actions, so that end() stays cheap.
+    it.ground_actions_ = impl_->pddl_.ListApplicableGroundActions(state());
+    if (it.ground_actions_.empty()) {
+      it.it_action_ = impl_->pddl_.actions().end();
+    } else if (!it.ExpandGroundAction()) {
+      ++it;
+    }
+    return it;
+  }
 
   if (it.it_param_ == it.it_action_->parameter_generator().end()) {
     ++it;
@@ -91,15 +136,13 @@ Planner::Node::iterator Planner::Node::begin() const {
   const Node& parent = it.parent_;
   if (action.IsValid(parent.state(), arguments)) {
     // Set action and apply postconditions to child
-    State state = action.Apply(parent.state(), arguments);
-    DerivedPredicate::Apply(impl_->pddl_.derived_predicates(), &state);
+    State state = parent.state();
+    impl_->pddl_.ApplyAction(action, arguments, &state);
     it.child_ =
         Node(parent, it.child_, std::move(state), action.to_string(arguments));
 
     // Return if state hasn't been previously visited
-    const std::shared_ptr<const Planner::Node::NodeImpl::Cache> ancestors =
-        it.child_->ancestors_;
-    if (ancestors->count(it.child_) == 0) return it;
+    if (it.IsNewChild()) return it;
   }
 
   ++it;
@@ -143,9 +186,50 @@ Planner::Node::iterator::iterator(const Node& parent)
     : pddl_(parent->pddl_),
       parent_(parent),
       it_action_(pddl_.actions().begin()),
-      it_param_(it_action_->parameter_generator().begin()) {}
+      it_param_(it_action_->parameter_generator().begin()),
+      is_grounded_(pddl_.is_grounded()) {}
+
+bool Planner::Node::iterator::ExpandGroundAction() {
+  const std::vector<GroundAction>& actions = pddl_.ground_actions();
+  const GroundAction& action = actions[ground_actions_[idx_ground_action_]];
+
+  // Actions with disjunctive preconditions are split into consecutive ground
+  // actions with the same arguments, which produce the same child.
+  if (idx_ground_action_ > 0) {
+    const GroundAction& prev = actions[ground_actions_[idx_ground_action_ - 1]];
+    if (&prev.action() == &action.action() &&
+        prev.arguments() == action.arguments()) {
+      return false;
+    }
+  }
+
+  // Apply the lifted action so that axioms are triggered as usual.
+  State state = parent_.state();
+  pddl_.ApplyAction(action.action(), action.arguments(), &state);
+  child_ = Node(parent_, child_, std::move(state), action.to_string());
+
+  // Return if state hasn't been previously visited
+  return IsNewChild();
+}
+
+bool Planner::Node::iterator::IsNewChild() const {
+  if (child_->closed_) return child_->closed_->count(child_.state()) == 0;
+  return child_->ancestors_->count(child_) == 0;
+}
 
 Planner::Node::iterator& Planner::Node::iterator::operator++() {
+  if (is_grounded_) {
+    while (it_action_ != pddl_.actions().end()) {
+      ++idx_ground_action_;
+      if (idx_ground_action_ >= ground_actions_.size()) {
+        it_action_ = pddl_.actions().end();
+        break;
+      }
+      if (ExpandGroundAction()) break;
+    }
+    return *this;
+  }
+
   while (it_action_ != pddl_.actions().end()) {
     const ParameterGenerator& param_gen = it_action_->parameter_generator();
     if (it_param_ == param_gen.end()) {
@@ -167,15 +251,13 @@ Planner::Node::iterator& Planner::Node::iterator::operator++() {
     const std::vector<Object>& arguments = *it_param_;
     if (action.IsValid(parent_.state(), arguments)) {
       // Set action and apply postconditions to child
-      State state = action.Apply(parent_.state(), arguments);
-      DerivedPredicate::Apply(pddl_.derived_predicates(), &state);
+      State state = parent_.state();
+      pddl_.ApplyAction(action, arguments, &state);
       child_ =
           Node(parent_, child_, std::move(state), action.to_string(arguments));
 
       // Return if state hasn't been previously visited
-      const std::shared_ptr<const Planner::Node::NodeImpl::Cache> ancestors =
-          child_->ancestors_;
-      if (ancestors->count(child_) == 0) break;
+      if (IsNewChild()) break;
     }
   }
 
@@ -183,6 +265,22 @@ Planner::Node::iterator& Planner::Node::iterator::operator++() {
 }
 
 Planner::Node::iterator& Planner::Node::iterator::operator--() {
+  if (is_grounded_) {
+    if (it_action_ == pddl_.actions().end()) {
+      // Iterators decremented from end() haven't listed the actions yet.
+      if (ground_actions_.empty()) {
+        ground_actions_ = pddl_.ListApplicableGroundActions(parent_.state());
+      }
+      it_action_ = pddl_.actions().begin();
+      idx_ground_action_ = ground_actions_.size();
+    }
+    while (idx_ground_action_ > 0) {
+      --idx_ground_action_;
+      if (ExpandGroundAction()) break;
+    }
+    return *this;
+  }
+
   if (it_action_ == pddl_.actions().end()) {
     --it_action_;
     const Action& action = *it_action_;
@@ -193,15 +291,13 @@ Planner::Node::iterator& Planner::Node::iterator::operator--() {
     const std::vector<Object>& arguments = *it_param_;
     if (action.IsValid(parent_.state(), arguments)) {
       // Set action and apply postconditions to child
-      State state = action.Apply(parent_.state(), arguments);
-      DerivedPredicate::Apply(pddl_.derived_predicates(), &state);
+      State state = parent_.state();
+      pddl_.ApplyAction(action, arguments, &state);
       child_ =
           Node(parent_, child_, std::move(state), action.to_string(arguments));
 
       // Return if state hasn't been previously visited
-      const std::shared_ptr<const Planner::Node::NodeImpl::Cache> ancestors =
-          child_->ancestors_;
-      if (ancestors->count(child_) == 0) return *this;
+      if (IsNewChild()) return *this;
     }
   }
 
@@ -224,15 +320,13 @@ Planner::Node::iterator& Planner::Node::iterator::operator--() {
     const std::vector<Object>& arguments = *it_param_;
     if (action.IsValid(parent_.state(), arguments)) {
       // Set action and apply postconditions to child
-      State state = action.Apply(parent_.state(), arguments);
-      DerivedPredicate::Apply(pddl_.derived_predicates(), &state);
+      State state = parent_.state();
+      pddl_.ApplyAction(action, arguments, &state);
       child_ =
           Node(parent_, child_, std::move(state), action.to_string(arguments));
 
       // Return if state hasn't been previously visited
-      const std::shared_ptr<const Planner::Node::NodeImpl::Cache> ancestors =
-          child_->ancestors_;
-      if (ancestors->count(child_) == 0) break;
+      if (IsNewChild()) break;
     }
   }
 
@@ -243,6 +337,39 @@ bool Planner::Node::iterator::operator==(const iterator& other) const {
   return it_action_ == other.it_action_ && it_action_ == pddl_.actions().end();
 }
 
+TEST_CASE_FIXTURE(testing::Fixture, "Planner.DuplicateDetection") {
+  Planner planner(pddl, Planner::DuplicateDetection::kGlobal);
+  BreadthFirstSearch<Planner::Node> bfs(planner.root(), 5);
+  const auto it = bfs.begin();
+  REQUIRE(it != bfs.end());
+
+  // The shortest plan is still found.
+  const std::vector<Planner::Node>& plan = *it;
+  REQUIRE(plan.size() == 6);
+  std::vector<std::string> actions;
+  for (size_t i = 1; i < plan.size(); i++) actions.push_back(plan[i].action());
+  REQUIRE(pddl.IsValidPlan(actions));
+
+  // Before any other expansion, iterating twice produces the same children
+  // as path duplicate detection.
+  const auto CountChildren = [](const Planner::Node& node) {
+    size_t num_children = 0;
+    for (auto it = node.begin(); it != node.end(); ++it) num_children++;
+    return num_children;
+  };
+  Planner planner_global(pddl, Planner::DuplicateDetection::kGlobal);
+  Planner planner_path(pddl);
+  const size_t num_children = CountChildren(planner_path.root());
+  REQUIRE(num_children > 0);
+  REQUIRE(CountChildren(planner_global.root()) == num_children);
+  REQUIRE(CountChildren(planner_global.root()) == num_children);
+
+  // Another node with an expanded state has no children.
+  const Planner::Node duplicate(planner_global.root(), Planner::Node(),
+                                State(planner_global.root().state()), "");
+  REQUIRE(duplicate.begin() == duplicate.end());
+}
+
 }  // namespace symbolic
 
 namespace std {
@@ -0,0 +1,275 @@
+/**
+ * regression_search.cc
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#include "symbolic/planning/regression_search.h"
+
+#include <algorithm>      // std::all_of, std::none_of
+#include <limits>         // std::numeric_limits
+#include <unordered_map>  // std::unordered_map
+#include <utility>        // std::move
+#include <vector>         // std::vector
+
+#include "symbolic/normal_form.h"
+#include "utils/doctest.h"
+
+namespace {
+
+using ::symbolic::PartialState;
+using ::symbolic::Proposition;
+using ::symbolic::State;
+
+constexpr size_t kNoParent = std::numeric_limits<size_t>::max();
+
+struct Node {
+  PartialState state;
+  size_t idx_parent;
+  size_t idx_operator;
+  size_t depth;
+};
+
+bool IsSubset(const State& lhs, const State& rhs) {
+  return lhs.size() <= rhs.size() &&
+         std::all_of(lhs.begin(), lhs.end(), [&rhs](const Proposition& prop) {
+           return rhs.contains(prop);
+         });
+}
+
+/**
+ * Index of the reached partial states by proposition.
+ *
+ * A reached state subsumes a new one if all of its propositions are in the new
+ * state, since every state satisfying the new one then also satisfies it.
+ * Counting the hits of each reached state over the propositions of the new
+ * state only visits the reached states that share a proposition with it,
+ * instead of comparing against every reached state.
+ */
+class SubsumptionIndex {
+ public:
+  /**
+   * Returns whether a partial state in the index subsumes the given one.
+   */
+  bool IsSubsumed(const PartialState& partial) {
+    if (has_empty_) return true;
+    const bool is_subsumed =
+        CountHits(pos_, partial.pos()) || CountHits(neg_, partial.neg());
+    for (const size_t id : touched_) counts_[id] = 0;
+    touched_.clear();
+    return is_subsumed;
+  }
+
+  void Insert(const PartialState& partial) {
+    const size_t id = sizes_.size();
+    sizes_.push_back(partial.pos().size() + partial.neg().size());
+    counts_.push_back(0);
+    if (sizes_.back() == 0) has_empty_ = true;
+    for (const Proposition& prop : partial.pos()) pos_[prop].push_back(id);
+    for (const Proposition& prop : partial.neg()) neg_[prop].push_back(id);
+  }
+
+ private:
+  using PropositionIndex = std::unordered_map<Proposition, std::vector<size_t>>;
+
+  /**
+   * Adds a hit to the reached states containing each of the propositions.
+   *
+   * @returns True once all the propositions of a reached state have been hit.
+   */
+  bool CountHits(const PropositionIndex& index, const State& props) {
+    for (const Proposition& prop : props) {
+      const auto it = index.find(prop);
+      if (it == index.end()) continue;
+      for (const size_t id : it->second) {
+        if (counts_[id]++ == 0) touched_.push_back(id);
+        if (counts_[id] == sizes_[id]) return true;
+      }
+    }
+    return false;
+  }
+
+  PropositionIndex pos_;
+  PropositionIndex neg_;
+  std::vector<size_t> sizes_;
+  std::vector<size_t> counts_;
+  std::vector<size_t> touched_;
+  bool has_empty_ = false;
+};
+
+bool IsSatisfied(const State& state, const PartialState& partial) {
+  return IsSubset(partial.pos(), state) &&
+         std::none_of(partial.neg().begin(), partial.neg().end(),
+                      [&state](const Proposition& prop) {
+                        return state.contains(prop);
+                      });
+}
+
+/**
+ * Regresses the partial state through the action's pre/post conditions.
+ *
+ * @returns Partial state that must hold before the action, or nullopt if the
+ *          action doesn't achieve any of the propositions or contradicts one.
+ */
+std::optional<PartialState> Regress(const PartialState& partial,
+                                    const PartialState& pre,
+                                    const PartialState& post) {
+  bool is_relevant = false;
+  for (const Proposition& prop : partial.pos()) {
+    if (post.neg().contains(prop)) return {};
+    is_relevant |= post.pos().contains(prop);
+  }
+  for (const Proposition& prop : partial.neg()) {
+    if (post.pos().contains(prop)) return {};
+    is_relevant |= post.neg().contains(prop);
+  }
+  if (!is_relevant) return {};
+
+  PartialState result = pre;
+  for (const Proposition& prop : partial.pos()) {
+    if (!post.pos().contains(prop)) result.pos().insert(prop);
+  }
+  for (const Proposition& prop : partial.neg()) {
+    if (!post.neg().contains(prop)) result.neg().insert(prop);
+  }
+  if (!result.IsConsistent()) return {};
+  return result;
+}
+
+}  // namespace
+
+namespace symbolic {
+
+RegressionSearch::RegressionSearch(const Pddl& pddl) : pddl_(pddl) {
+  for (const Action& action : pddl.actions()) {
+    const ParameterGenerator& param_gen = action.parameter_generator();
+    const size_t num_params =
+        action.parameters().empty() ? 1 : param_gen.size();
+    for (size_t i = 0; i < num_params; i++) {
+      std::vector<Object> arguments;
+      if (!action.parameters().empty()) arguments = param_gen[i];
+
+      // Skip preconditions that are always false.
+      std::optional<DisjunctiveFormula> pre =
+          DisjunctiveFormula::Create(pddl, action.preconditions().symbol(),
+                                     action.parameters(), arguments);
+      if (!pre.has_value()) continue;
+      if (pre->empty()) pre->conjunctions.emplace_back();
+
+      // Skip actions without effects or with conditional effects.
+      std::optional<DisjunctiveFormula> post = DisjunctiveFormula::Create(
+          pddl, action.postconditions(), action.parameters(), arguments);
+      if (!post.has_value() || post->conjunctions.size() != 1) continue;
+
+      const std::string action_call = action.to_string(arguments);
+      for (PartialState& conj : pre->conjunctions) {
+        if (!conj.IsConsistent()) continue;
+        operators_.push_back(
+            {action_call, std::move(conj), post->conjunctions.front()});
+      }
+    }
+  }
+}
+
+std::optional<std::vector<std::string>> RegressionSearch::Search(
+    const State& state, size_t max_depth) {
+  statistics_ = Statistics();
+  const State initial_state =
+      pddl_.DerivedState(pddl_.ConsistentState(state));
+
+  const std::optional<DisjunctiveFormula> goal =
+      DisjunctiveFormula::NormalizeGoal(pddl_);
+  if (!goal.has_value()) return {};
+  if (goal->empty()) return std::vector<std::string>();
+
+  std::vector<Node> nodes;
+
+  // Follows the parents from the node to the goal, which gives the actions in
+  // the order they are applied.
+  const auto GetPlan = [this, &nodes](size_t idx_node) {
+    std::vector<std::string> plan;
+    for (size_t idx = idx_node; nodes[idx].idx_parent != kNoParent;
+         idx = nodes[idx].idx_parent) {
+      plan.push_back(operators_[nodes[idx].idx_operator].action_call);
+    }
+    return plan;
+  };
+
+  SubsumptionIndex reached;
+
+  for (const PartialState& conj : goal->conjunctions) {
+    if (!conj.IsConsistent() || !Axiom::IsConsistent(pddl_.axioms(), conj)) {
+      continue;
+    }
+    if (reached.IsSubsumed(conj)) continue;
+    reached.Insert(conj);
+    nodes.push_back({conj, kNoParent, 0, 0});
+    if (IsSatisfied(initial_state, conj)) return GetPlan(nodes.size() - 1);
+  }
+
+  // The node table doubles as the queue, since nodes are appended in
+  // breadth-first order.
+  for (size_t idx_node = 0; idx_node < nodes.size(); idx_node++) {
+    const size_t depth = nodes[idx_node].depth;
+    if (max_depth > 0 && depth >= max_depth) break;
+
+    // Copy the state since appending nodes may reallocate the table.
+    const PartialState partial = nodes[idx_node].state;
+    statistics_.num_expanded++;
+    for (size_t idx_op = 0; idx_op < operators_.size(); idx_op++) {
+      const Operator& op = operators_[idx_op];
+      std::optional<PartialState> regressed =
+          Regress(partial, op.pre, op.post);
+      if (!regressed.has_value()) continue;
+      statistics_.num_generated++;
+
+      if (!Axiom::IsConsistent(pddl_.axioms(), *regressed)) continue;
+      if (reached.IsSubsumed(*regressed)) {
+        statistics_.num_subsumed++;
+        continue;
+      }
+
+      reached.Insert(*regressed);
+      nodes.push_back({std::move(*regressed), idx_node, idx_op, depth + 1});
+      if (IsSatisfied(initial_state, nodes.back().state)) {
+        return GetPlan(nodes.size() - 1);
+      }
+    }
+  }
+  return {};
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "RegressionSearch") {
+  RegressionSearch search(pddl);
+  const std::optional<std::vector<std::string>> plan =
+      search.Search(pddl.initial_state());
+  REQUIRE(plan.has_value());
+  REQUIRE(plan->size() == 5);
+  REQUIRE(pddl.IsValidPlan(*plan));
+  REQUIRE(!search.Search(pddl.initial_state(), 4).has_value());
+  REQUIRE(search.statistics().num_subsumed > 0);
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "RegressionSearch.SubsumptionIndex") {
+  SubsumptionIndex reached;
+  reached.Insert(PartialState(pddl, {"on(box, shelf)"}, {"inhand(box)"}));
+  REQUIRE(reached.IsSubsumed(PartialState(
+      pddl, {"on(box, shelf)", "on(hook, table)"}, {"inhand(box)"})));
+  REQUIRE(!reached.IsSubsumed(PartialState(pddl, {"on(box, shelf)"}, {})));
+  REQUIRE(!reached.IsSubsumed(
+      PartialState(pddl, {"on(box, shelf)", "inhand(box)"}, {})));
+
+  reached.Insert(PartialState(pddl, {"on(hook, table)"}, {}));
+  REQUIRE(reached.IsSubsumed(
+      PartialState(pddl, {"on(hook, table)"}, {"inhand(hook)"})));
+  REQUIRE(!reached.IsSubsumed(PartialState(pddl, {"on(box, shelf)"}, {})));
+
+  // The empty partial state subsumes every other one.
+  reached.Insert(PartialState());
+  REQUIRE(reached.IsSubsumed(PartialState(pddl, {"on(box, shelf)"}, {})));
+}
+
+}  // namespace symbolic
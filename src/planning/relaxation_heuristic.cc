@@ -0,0 +1,146 @@
+/**
+ * relaxation_heuristic.cc
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#include "symbolic/planning/relaxation_heuristic.h"
+
+#include <algorithm>   // std::max, std::sort, std::unique
+#include <functional>  // std::greater
+#include <limits>      // std::numeric_limits
+#include <queue>       // std::priority_queue
+#include <utility>     // std::pair
+#include <vector>      // std::vector
+
+#include "utils/doctest.h"
+
+namespace {
+
+constexpr size_t kNoSupporter = std::numeric_limits<size_t>::max();
+
+}  // namespace
+
+namespace symbolic {
+
+RelaxationHeuristic::RelaxationHeuristic(const Pddl& pddl, Type type)
+    : task_(pddl), type_(type) {}
+
+size_t RelaxationHeuristic::operator()(const State& state) const {
+  return (*this)(pddl().state_index().GetIndexedState(state));
+}
+
+size_t RelaxationHeuristic::operator()(
+    const StateIndex::IndexedState& state) const {
+  // Generalized Dijkstra over the propositions. A unit fires once all of its
+  // preconditions have been popped, at which point their costs are final.
+  const size_t num_props = task_.num_propositions();
+  std::vector<size_t> costs(num_props, kInfinity);
+  std::vector<size_t> supporters(num_props, kNoSupporter);
+  using QueueEntry = std::pair<size_t, size_t>;  // (cost, idx_prop)
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+                      std::greater<QueueEntry>>
+      queue;
+  const auto Reach = [&](size_t idx_prop, size_t cost, size_t idx_unit) {
+    if (cost >= costs[idx_prop]) return;
+    costs[idx_prop] = cost;
+    supporters[idx_prop] = idx_unit;
+    queue.emplace(cost, idx_prop);
+  };
+
+  const std::vector<RelaxedTask::Unit>& units = task_.units();
+  std::vector<size_t> num_unreached(units.size());
+  std::vector<size_t> unit_costs(units.size(), 0);
+  const auto Fire = [&](size_t idx_unit) {
+    for (const size_t idx_prop : units[idx_unit].add) {
+      Reach(idx_prop, unit_costs[idx_unit] + 1, idx_unit);
+    }
+  };
+
+  for (size_t i = 0; i < num_props; i++) {
+    if (state[i] || task_.is_free(i)) Reach(i, 0, kNoSupporter);
+  }
+  for (size_t i = 0; i < units.size(); i++) {
+    num_unreached[i] = units[i].pre.size();
+    if (num_unreached[i] == 0) Fire(i);
+  }
+
+  while (!queue.empty()) {
+    const QueueEntry top = queue.top();
+    queue.pop();
+    const size_t cost = top.first;
+    const size_t idx_prop = top.second;
+    if (cost > costs[idx_prop]) continue;
+
+    for (const size_t idx_unit : task_.watchers(idx_prop)) {
+      unit_costs[idx_unit] = type_ == Type::kMax
+                                 ? std::max(unit_costs[idx_unit], cost)
+                                 : unit_costs[idx_unit] + cost;
+      if (--num_unreached[idx_unit] == 0) Fire(idx_unit);
+    }
+  }
+
+  // Evaluate the cheapest disjunct of the goal.
+  size_t h = kInfinity;
+  const GroundConjunction* goal = nullptr;
+  for (const GroundConjunction& conj : task_.goal()) {
+    size_t h_conj = 0;
+    for (const size_t idx_prop : conj.pos) {
+      if (costs[idx_prop] == kInfinity) {
+        h_conj = kInfinity;
+        break;
+      }
+      h_conj = type_ == Type::kMax ? std::max(h_conj, costs[idx_prop])
+                                   : h_conj + costs[idx_prop];
+    }
+    if (h_conj < h) {
+      h = h_conj;
+      goal = &conj;
+    }
+  }
+  if (type_ != Type::kFF || goal == nullptr) return h;
+
+  // Extract a relaxed plan by following the best supporters back from the
+  // goal, and count its distinct actions.
+  std::vector<bool> is_marked(num_props, false);
+  std::vector<size_t> stack = goal->pos;
+  std::vector<size_t> actions;
+  while (!stack.empty()) {
+    const size_t idx_prop = stack.back();
+    stack.pop_back();
+    if (is_marked[idx_prop]) continue;
+    is_marked[idx_prop] = true;
+
+    const size_t idx_unit = supporters[idx_prop];
+    if (idx_unit == kNoSupporter) continue;
+    const RelaxedTask::Unit& unit = units[idx_unit];
+    actions.push_back(unit.id_action);
+    for (const size_t idx_pre : unit.pre) {
+      if (!is_marked[idx_pre]) stack.push_back(idx_pre);
+    }
+  }
+  std::sort(actions.begin(), actions.end());
+  return std::unique(actions.begin(), actions.end()) - actions.begin();
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "RelaxationHeuristic") {
+  pddl.Ground();
+  const State& state = pddl.initial_state();
+  const size_t h_add =
+      RelaxationHeuristic(pddl, RelaxationHeuristic::Type::kAdd)(state);
+  const size_t h_max =
+      RelaxationHeuristic(pddl, RelaxationHeuristic::Type::kMax)(state);
+  const size_t h_ff =
+      RelaxationHeuristic(pddl, RelaxationHeuristic::Type::kFF)(state);
+
+  // The shortest plan has 5 actions.
+  REQUIRE(h_max > 0);
+  REQUIRE(h_max <= 5);
+  REQUIRE(h_max <= h_ff);
+  REQUIRE(h_ff <= h_add);
+}
+
+}  // namespace symbolic
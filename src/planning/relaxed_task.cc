@@ -0,0 +1,82 @@
+/**
+ * relaxed_task.cc
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#include "symbolic/planning/relaxed_task.h"
+
+#include <VAL/ptree.h>
+
+#include <algorithm>  // std::sort, std::unique
+#include <exception>  // std::runtime_error
+#include <memory>     // std::shared_ptr
+#include <set>        // std::set
+#include <string>     // std::string
+#include <utility>    // std::move
+
+namespace {
+
+using ::symbolic::GroundAction;
+using ::symbolic::GroundConditionalEffect;
+
+std::vector<size_t> Union(const std::vector<size_t>& a,
+                          const std::vector<size_t>& b) {
+  std::vector<size_t> c = a;
+  c.insert(c.end(), b.begin(), b.end());
+  std::sort(c.begin(), c.end());
+  c.erase(std::unique(c.begin(), c.end()), c.end());
+  return c;
+}
+
+}  // namespace
+
+namespace symbolic {
+
+RelaxedTask::RelaxedTask(const Pddl& pddl)
+    : pddl_(&pddl), goal_(GroundAction::GroundGoal(pddl)) {
+  if (!pddl.is_grounded()) {
+    throw std::runtime_error(
+        "RelaxedTask::RelaxedTask(): Actions have not been grounded.");
+  }
+
+  // Propositions that aren't controlled by the ground actions.
+  const StateIndex& state_index = pddl.state_index();
+  std::set<std::string> unconstrained;
+  for (const DerivedPredicate& pred : pddl.derived_predicates()) {
+    unconstrained.insert(pred.name());
+  }
+  for (const std::shared_ptr<Axiom>& axiom : pddl.axioms()) {
+    AddEffectPredicates(axiom->postconditions(), &unconstrained);
+  }
+  is_free_.resize(state_index.size(), false);
+  if (!unconstrained.empty()) {
+    for (size_t i = 0; i < state_index.size(); i++) {
+      is_free_[i] = unconstrained.count(state_index.GetProposition(i).name());
+    }
+  }
+
+  // Create units and index them by their preconditions.
+  watchers_.resize(state_index.size());
+  const auto AddUnit = [this](size_t id_action, std::vector<size_t>&& pre,
+                              const std::vector<size_t>& add) {
+    if (add.empty()) return;
+    for (const size_t idx_prop : pre) {
+      watchers_[idx_prop].push_back(units_.size());
+    }
+    units_.push_back({id_action, std::move(pre), add});
+  };
+  for (const GroundAction& action : pddl.ground_actions()) {
+    AddUnit(action.id(), std::vector<size_t>(action.pre_pos()),
+            action.add_effects());
+    for (const GroundConditionalEffect& effect : action.conditional_effects()) {
+      AddUnit(action.id(), Union(action.pre_pos(), effect.pre_pos),
+              effect.add_effects);
+    }
+  }
+}
+
+}  // namespace symbolic
@@ -16,17 +16,40 @@
 
 #include <exception>  // std::out_of_range
 #include <sstream>    // std::stringstream
+#include <thread>     // std::thread
+#include <utility>    // std::move, std::pair
 
 #include "symbolic/normal_form.h"
 #include "symbolic/pddl.h"
+#include "symbolic/planning/best_first_search.h"
 #include "symbolic/planning/breadth_first_search.h"
+#include "symbolic/planning/hash_distributed_a_star.h"
+#include "symbolic/planning/in_place_depth_first_search.h"
+#include "symbolic/planning/iterative_deepening_search.h"
+#include "symbolic/planning/landmark_graph.h"
+#include "symbolic/planning/parallel_breadth_first_search.h"
+#include "symbolic/planning/parallel_depth_first_search.h"
+#include "symbolic/planning/pattern_database.h"
 #include "symbolic/planning/planner.h"
+#include "symbolic/planning/regression_search.h"
+#include "symbolic/planning/relaxation_heuristic.h"
 
 namespace {
 
+using ::symbolic::BestFirstSearch;
+using ::symbolic::HashDistributedAStar;
+using ::symbolic::IterativeDeepeningSearch;
+using ::symbolic::LandmarkCountHeuristic;
+using ::symbolic::LandmarkGraph;
 using ::symbolic::Object;
+using ::symbolic::ParallelBreadthFirstSearch;
+using ::symbolic::ParallelDepthFirstSearch;
+using ::symbolic::PatternDatabase;
+using ::symbolic::PatternDatabaseHeuristic;
 using ::symbolic::Pddl;
 using ::symbolic::Planner;
+using ::symbolic::RegressionSearch;
+using ::symbolic::RelaxationHeuristic;
 using ::symbolic::State;
 
 using StringSet = std::set<std::string>;
@@ -51,6 +74,41 @@ std::vector<Object> ParseObjects(const Pddl& pddl,
   return objects;
 }
 
+/**
+ * Wraps a heuristic object for the searches, which must outlive them.
+ */
+template <typename HeuristicT>
+BestFirstSearch::Heuristic WrapHeuristic(const HeuristicT& heuristic) {
+  return [&heuristic](const ::symbolic::StateIndex::IndexedState& state) {
+    return heuristic(state);
+  };
+}
+
+template <typename HeuristicT>
+BestFirstSearch CreateBestFirstSearch(const Pddl& pddl,
+                                      const HeuristicT& heuristic,
+                                      double weight) {
+  return BestFirstSearch(pddl, WrapHeuristic(heuristic), weight);
+}
+
+template <typename HeuristicT>
+HashDistributedAStar CreateHashDistributedAStar(const Pddl& pddl,
+                                                const HeuristicT& heuristic,
+                                                ThreadPool* pool) {
+  return HashDistributedAStar(pddl, WrapHeuristic(heuristic), pool);
+}
+
+/**
+ * Evaluates the heuristic in the state, with None for dead ends.
+ */
+template <typename HeuristicT>
+std::optional<size_t> EvaluateHeuristic(const HeuristicT& heuristic,
+                                        const StringSet& state) {
+  const size_t h = heuristic(ParseState(heuristic.pddl(), state));
+  if (h == RelaxationHeuristic::kInfinity) return {};
+  return h;
+}
+
 struct BreadthFirstSearch {
   BreadthFirstSearch(const Planner::Node& root, size_t max_depth, bool verbose,
                      double timeout)
@@ -80,6 +138,19 @@ PYBIND11_MODULE(pysymbolic, m) {
     .. currentmodule:: symbolic
   )pbdoc";
 
+  // ThreadPool
+  py::class_<ThreadPool>(m, "ThreadPool")
+      .def(py::init<size_t>(),
+           "num_threads"_a = std::thread::hardware_concurrency(), R"pbdoc(
+             Worker threads that are kept alive between parallel calls.
+
+             Args:
+                 num_threads: Number of threads, including the calling thread.
+
+             .. seealso:: C++: :symbolic:`symbolic::ThreadPool`.
+           )pbdoc")
+      .def_property_readonly("num_threads", &ThreadPool::num_threads);
+
   // Pddl
   py::class_<Pddl>(m, "Pddl")
       .def(py::init<const std::string&, const std::string&, bool>(), "domain"_a,
@@ -177,6 +248,39 @@ PYBIND11_MODULE(pysymbolic, m) {
 
             .. seealso:: C++: :symbolic:`symbolic::Pddl::Execute`.
           )pbdoc")
+      .def(
+          "next_state",
+          [](const Pddl& pddl, const std::unordered_set<std::string>& state,
+             const GroundActionHandle& action) {
+            return pddl.NextState(State(pddl, state), action).Stringify();
+          },
+          "state"_a, "action"_a)
+      .def(
+          "apply_actions",
+          [](const Pddl& pddl, const std::unordered_set<std::string>& state,
+             const std::vector<GroundActionHandle>& actions) {
+            return pddl.ApplyActions(State(pddl, state), actions).Stringify();
+          },
+          "state"_a, "action"_a)
+      .def("resolve_action", &Pddl::ResolveAction, "action_call"_a, R"pbdoc(
+            Resolves an action call into a handle that can be applied or
+            validated repeatedly without parsing the string again.
+
+            Args:
+                action_call: Action call in the form of :code:`"action(obj_a, obj_b)"`.
+            Returns:
+                Ground action handle.
+
+            Example:
+                >>> import symbolic
+                >>> pddl = symbolic.Pddl("../resources/domain.pddl", "../resources/problem.pddl")
+                >>> action = pddl.resolve_action("pick(hook)")
+                >>> pddl.is_valid_action(pddl.initial_state, action)
+                True
+
+            .. seealso:: C++: :symbolic:`symbolic::Pddl::ResolveAction`.
+          )pbdoc")
+      .def("resolve_actions", &Pddl::ResolveActions, "action_calls"_a)
       .def(
           "derived_state",
           [](const Pddl& pddl, const std::unordered_set<std::string>& state) {
@@ -242,6 +346,13 @@ PYBIND11_MODULE(pysymbolic, m) {
 
             .. seealso:: C++: :symbolic:`symbolic::Pddl::IsValidAction`.
           )pbdoc")
+      .def(
+          "is_valid_action",
+          [](const Pddl& pddl, const std::unordered_set<std::string>& state,
+             const GroundActionHandle& action) {
+            return pddl.IsValidAction(State(pddl, state), action);
+          },
+          "state"_a, "action"_a)
       .def(
           "is_valid_state",
           [](const Pddl& pddl, const std::unordered_set<std::string>& state) {
@@ -274,6 +385,189 @@ PYBIND11_MODULE(pysymbolic, m) {
 
             .. seealso:: C++: :symbolic:`symbolic::Pddl::IsValidState`.
           )pbdoc")
+      .def("set_formula_profiling", &Pddl::set_formula_profiling,
+           "profiling"_a, R"pbdoc(
+            Enables or disables profiling of the action preconditions and goal.
+
+            Args:
+                profiling: Whether to count conjunct evaluations and failures.
+
+            .. seealso:: C++: :symbolic:`symbolic::Pddl::set_formula_profiling`.
+          )pbdoc")
+      .def("reorder_conjuncts", &Pddl::ReorderConjuncts, R"pbdoc(
+            Reorders the profiled formulas so that the conjuncts with the
+            highest observed failure rate are evaluated first.
+
+            .. seealso:: C++: :symbolic:`symbolic::Pddl::ReorderConjuncts`.
+          )pbdoc")
+      .def("save_conjunct_order", &Pddl::SaveConjunctOrder, "filename"_a,
+           R"pbdoc(
+            Saves the conjunct order of the action preconditions.
+
+            Args:
+                filename: Path of the output file.
+
+            .. seealso:: C++: :symbolic:`symbolic::Pddl::SaveConjunctOrder`.
+          )pbdoc")
+      .def("load_conjunct_order", &Pddl::LoadConjunctOrder, "filename"_a,
+           R"pbdoc(
+            Loads the conjunct order of the action preconditions.
+
+            Args:
+                filename: Path of the input file.
+
+            .. seealso:: C++: :symbolic:`symbolic::Pddl::LoadConjunctOrder`.
+          )pbdoc")
+      .def("ground", &Pddl::Ground, py::return_value_policy::reference_internal,
+           R"pbdoc(
+            Grounds the actions into a table of ground actions.
+
+            Returns:
+                List of ground actions, indexed by their ids.
+
+            .. seealso:: C++: :symbolic:`symbolic::Pddl::Ground`.
+          )pbdoc")
+      .def_property_readonly("is_grounded", &Pddl::is_grounded)
+      .def_property_readonly("ground_actions", &Pddl::ground_actions,
+                             py::return_value_policy::reference_internal)
+      .def("analyze_reachability", &Pddl::AnalyzeReachability,
+           "prune"_a = false, R"pbdoc(
+            Computes the propositions and ground actions reachable from the
+            initial state under the delete relaxation.
+
+            Args:
+                prune: Whether to remove the unreachable ground actions and
+                    restrict the action parameter domains.
+            Returns:
+                Reachable proposition indices and ground action ids.
+
+            .. seealso:: C++: :symbolic:`symbolic::Pddl::AnalyzeReachability`.
+          )pbdoc")
+      .def(
+          "list_applicable_ground_actions",
+          [](const Pddl& pddl, const std::unordered_set<std::string>& state) {
+            return pddl.ListApplicableGroundActions(State(pddl, state));
+          },
+          "state"_a, R"pbdoc(
+            Lists the ground actions applicable in the given state.
+
+            The actions must have been grounded with :func:`Pddl.ground`.
+
+            Args:
+                state: Current state.
+            Returns:
+                Ids of the applicable ground actions in increasing order.
+
+            .. seealso:: C++: :symbolic:`symbolic::Pddl::ListApplicableGroundActions`.
+          )pbdoc")
+      .def(
+          "next_states",
+          [](const Pddl& pddl,
+             const std::vector<std::unordered_set<std::string>>& str_states,
+             const std::vector<size_t>& actions, ThreadPool* pool) {
+            std::vector<State> states;
+            states.reserve(str_states.size());
+            for (const std::unordered_set<std::string>& str_state :
+                 str_states) {
+              states.emplace_back(pddl, str_state);
+            }
+            const std::vector<State> next_states =
+                pddl.NextStates(states, actions, pool);
+            std::vector<std::unordered_set<std::string>> str_next_states;
+            str_next_states.reserve(next_states.size());
+            for (const State& next_state : next_states) {
+              str_next_states.push_back(next_state.Stringify());
+            }
+            return str_next_states;
+          },
+          "states"_a, "actions"_a, "pool"_a,
+          py::call_guard<py::gil_scoped_release>(), R"pbdoc(
+            Applies ground actions to a batch of states in parallel.
+
+            The actions must have been grounded with :func:`Pddl.ground`.
+
+            Args:
+                states: Current states.
+                actions: Ground action ids, one per state.
+                pool: Thread pool that applies the actions.
+            Returns:
+                Next states.
+
+            .. seealso:: C++: :symbolic:`symbolic::Pddl::NextStates`.
+          )pbdoc")
+      .def("next_states",
+           static_cast<StateIndex::IndexedStates (Pddl::*)(
+               Eigen::Ref<const StateIndex::IndexedStates>,
+               const std::vector<size_t>&, ThreadPool*) const>(
+               &Pddl::NextStates),
+           "states"_a, "actions"_a, "pool"_a,
+           py::call_guard<py::gil_scoped_release>(), R"pbdoc(
+             Applies ground actions to a batch of indexed states, with one
+             state per row, in parallel.
+
+             .. seealso:: C++: :symbolic:`symbolic::Pddl::NextStates`.
+           )pbdoc")
+      .def(
+          "is_valid_tuples",
+          [](const Pddl& pddl,
+             const std::vector<std::unordered_set<std::string>>& str_states,
+             const std::vector<size_t>& actions,
+             const std::vector<std::unordered_set<std::string>>&
+                 str_next_states,
+             ThreadPool* pool) {
+            std::vector<State> states;
+            std::vector<State> next_states;
+            states.reserve(str_states.size());
+            next_states.reserve(str_next_states.size());
+            for (const std::unordered_set<std::string>& str_state :
+                 str_states) {
+              states.emplace_back(pddl, str_state);
+            }
+            for (const std::unordered_set<std::string>& str_state :
+                 str_next_states) {
+              next_states.emplace_back(pddl, str_state);
+            }
+            return pddl.IsValidTuples(states, actions, next_states, pool);
+          },
+          "states"_a, "actions"_a, "next_states"_a, "pool"_a,
+          py::call_guard<py::gil_scoped_release>(), R"pbdoc(
+            Evaluates whether a batch of (s, a, s') tuples are valid in
+            parallel.
+
+            The actions must have been grounded with :func:`Pddl.ground`.
+
+            Args:
+                states: Current states.
+                actions: Ground action ids, one per state.
+                next_states: Next states.
+                pool: Thread pool that evaluates the tuples.
+            Returns:
+                Validity of each tuple.
+
+            .. seealso:: C++: :symbolic:`symbolic::Pddl::IsValidTuples`.
+          )pbdoc")
+      .def("is_valid_tuples",
+           static_cast<Eigen::Array<bool, Eigen::Dynamic, 1> (Pddl::*)(
+               Eigen::Ref<const StateIndex::IndexedStates>,
+               const std::vector<size_t>&,
+               Eigen::Ref<const StateIndex::IndexedStates>, ThreadPool*)
+                           const>(&Pddl::IsValidTuples),
+           "states"_a, "actions"_a, "next_states"_a, "pool"_a,
+           py::call_guard<py::gil_scoped_release>(), R"pbdoc(
+             Evaluates whether a batch of indexed (s, a, s') tuples, with one
+             state per row, are valid in parallel.
+
+             .. seealso:: C++: :symbolic:`symbolic::Pddl::IsValidTuples`.
+           )pbdoc")
+      .def_property_readonly("relevance_index", &Pddl::relevance_index,
+                             py::return_value_policy::reference_internal,
+                             R"pbdoc(
+          Indexes from predicates, and from ground propositions once the
+          actions are grounded, to the actions that add, delete or require
+          them.
+
+          :type: RelevanceIndex
+      )pbdoc")
       .def("add_object", &Pddl::AddObject, "name"_a, "type"_a)
       .def("remove_object", &Pddl::RemoveObject, "name"_a)
       .def_property_readonly("name", &Pddl::name, R"pbdoc(
@@ -297,16 +591,69 @@ PYBIND11_MODULE(pysymbolic, m) {
       .def_property_readonly("predicates", &Pddl::predicates)
       .def_property_readonly("axioms", &Pddl::axioms)
       .def_property_readonly("derived_predicates", &Pddl::derived_predicates)
+      .def_property_readonly("static_predicates", &Pddl::static_predicates,
+                             R"pbdoc(
+          Predicates that are not modified by any action or axiom.
+
+          :type: Set[str]
+      )pbdoc")
+      .def_property_readonly(
+          "static_state",
+          [](const Pddl& pddl) { return Stringify(pddl.static_state()); },
+          R"pbdoc(
+          Static propositions of the initial state.
+
+          :type: Set[str]
+      )pbdoc")
       .def_property_readonly("state_index", &Pddl::state_index)
       .def_property_readonly("goal", &Pddl::goal)
       .def("is_valid_tuple",
            static_cast<bool (Pddl::*)(const StringSet&, const std::string&,
                                       const StringSet&) const>(
                &Pddl::IsValidTuple))
+      .def(
+          "is_valid_tuple",
+          [](const Pddl& pddl, const std::unordered_set<std::string>& state,
+             const GroundActionHandle& action,
+             const std::unordered_set<std::string>& next_state) {
+            return pddl.IsValidTuple(State(pddl, state), action,
+                                     State(pddl, next_state));
+          },
+          "state"_a, "action"_a, "next_state"_a)
       .def("is_goal_satisfied",
            static_cast<bool (Pddl::*)(const std::set<std::string>&) const>(
                &Pddl::IsGoalSatisfied))
-      .def("is_valid_plan", &Pddl::IsValidPlan)
+      .def(
+          "count_unsatisfied_goals",
+          [](const Pddl& pddl, const std::unordered_set<std::string>& state) {
+            std::vector<bool> satisfied;
+            const size_t num_unsatisfied =
+                pddl.CountUnsatisfiedGoals(State(pddl, state), &satisfied);
+            return std::make_pair(num_unsatisfied, std::move(satisfied));
+          },
+          "state"_a, R"pbdoc(
+            Counts the unsatisfied top-level goal conjuncts.
+
+            Args:
+                state: Current state.
+            Returns:
+                (num_unsatisfied, satisfied) pair, where satisfied lists
+                whether each goal conjunct holds in source order.
+
+            Example:
+                >>> import symbolic
+                >>> pddl = symbolic.Pddl("../resources/domain.pddl", "../resources/problem.pddl")
+                >>> pddl.count_unsatisfied_goals(pddl.initial_state)
+                (1, [True, True, False])
+
+            .. seealso:: C++: :symbolic:`symbolic::Pddl::CountUnsatisfiedGoals`.
+          )pbdoc")
+      .def("is_valid_plan",
+           static_cast<bool (Pddl::*)(const StringVector&) const>(
+               &Pddl::IsValidPlan))
+      .def("is_valid_plan",
+           static_cast<bool (Pddl::*)(const std::vector<GroundActionHandle>&)
+                           const>(&Pddl::IsValidPlan))
       .def("list_valid_arguments",
            static_cast<std::vector<StringVector> (Pddl::*)(
                const StringSet&, const std::string&) const>(
@@ -314,6 +661,16 @@ PYBIND11_MODULE(pysymbolic, m) {
       .def("list_valid_actions",
            static_cast<StringVector (Pddl::*)(const StringSet&) const>(
                &Pddl::ListValidActions))
+      .def("list_valid_actions",
+           static_cast<StringVector (Pddl::*)(const StringSet&, ThreadPool*)
+                           const>(&Pddl::ListValidActions),
+           "state"_a, "pool"_a, py::call_guard<py::gil_scoped_release>(),
+           R"pbdoc(
+             List the valid actions in parallel on the thread pool, in the same
+             order as the serial version.
+
+             .. seealso:: C++: :symbolic:`symbolic::Pddl::ListValidActions`.
+           )pbdoc")
       .def_property_readonly("domain_pddl", &Pddl::domain_pddl)
       .def_property_readonly("problem_pddl", &Pddl::problem_pddl)
       .def("__repr__",
@@ -360,6 +717,79 @@ PYBIND11_MODULE(pysymbolic, m) {
       .def("__repr__",
            static_cast<std::string (Action::*)() const>(&Action::to_string));
 
+  // GroundAction
+  py::class_<GroundAction>(m, "GroundAction")
+      .def_property_readonly("id", &GroundAction::id)
+      .def_property_readonly("action", &GroundAction::action,
+                             py::return_value_policy::reference_internal)
+      .def_property_readonly("arguments",
+                             [](const GroundAction& action) {
+                               return Stringify(action.arguments());
+                             })
+      .def_property_readonly("pre_pos", &GroundAction::pre_pos, R"pbdoc(
+          Positive precondition proposition indices.
+      )pbdoc")
+      .def_property_readonly("pre_neg", &GroundAction::pre_neg, R"pbdoc(
+          Negative precondition proposition indices.
+      )pbdoc")
+      .def_property_readonly("add_effects", &GroundAction::add_effects)
+      .def_property_readonly("del_effects", &GroundAction::del_effects)
+      .def_property_readonly("conditional_effects",
+                             &GroundAction::conditional_effects)
+      .def("is_applicable",
+           [](const GroundAction& action,
+              // NOLINTNEXTLINE(performance-unnecessary-value-param)
+              Eigen::Ref<const StateIndex::IndexedState> indexed_state) {
+             return action.IsApplicable(indexed_state);
+           })
+      .def("apply",
+           [](const GroundAction& action,
+              // NOLINTNEXTLINE(performance-unnecessary-value-param)
+              Eigen::Ref<const StateIndex::IndexedState> indexed_state) {
+             StateIndex::IndexedState next_state = indexed_state;
+             action.Apply(&next_state);
+             return next_state;
+           })
+      .def("__repr__", &GroundAction::to_string);
+
+  // GroundActionHandle
+  py::class_<GroundActionHandle>(m, "GroundActionHandle")
+      .def_readonly("idx_action", &GroundActionHandle::idx_action)
+      .def_property_readonly("arguments",
+                             [](const GroundActionHandle& action) {
+                               return Stringify(action.arguments);
+                             })
+      .def("__eq__", [](const GroundActionHandle& lhs,
+                        const GroundActionHandle& rhs) { return lhs == rhs; });
+
+  // GroundConditionalEffect
+  py::class_<GroundConditionalEffect>(m, "GroundConditionalEffect")
+      .def_readonly("pre_pos", &GroundConditionalEffect::pre_pos)
+      .def_readonly("pre_neg", &GroundConditionalEffect::pre_neg)
+      .def_readonly("add_effects", &GroundConditionalEffect::add_effects)
+      .def_readonly("del_effects", &GroundConditionalEffect::del_effects);
+
+  // Reachability
+  py::class_<Reachability>(m, "Reachability")
+      .def_readonly("propositions", &Reachability::propositions)
+      .def_readonly("actions", &Reachability::actions);
+
+  // RelevantActions
+  py::class_<RelevantActions>(m, "RelevantActions")
+      .def_readonly("add", &RelevantActions::add)
+      .def_readonly("delete", &RelevantActions::del)
+      .def_readonly("pre_pos", &RelevantActions::pre_pos)
+      .def_readonly("pre_neg", &RelevantActions::pre_neg);
+
+  // RelevanceIndex
+  py::class_<RelevanceIndex>(m, "RelevanceIndex")
+      .def("predicate", &RelevanceIndex::predicate,
+           py::return_value_policy::reference_internal, "name_predicate"_a)
+      .def("proposition", &RelevanceIndex::proposition,
+           py::return_value_policy::reference_internal, "idx_proposition"_a)
+      .def_property_readonly("predicates", &RelevanceIndex::predicates)
+      .def_property_readonly("propositions", &RelevanceIndex::propositions);
+
   // Predicate
   py::class_<Predicate>(m, "Predicate")
       .def_property_readonly("name", &Predicate::name, R"pbdoc(
@@ -549,24 +979,36 @@ PYBIND11_MODULE(pysymbolic, m) {
       });
 
   // Planner
-  py::class_<Planner>(m, "Planner")
-      .def(py::init<const Pddl&>(), "pddl"_a, R"pbdoc(
+  py::class_<Planner> planner(m, "Planner");
+  py::enum_<Planner::DuplicateDetection>(planner, "DuplicateDetection")
+      .value("PATH", Planner::DuplicateDetection::kPath)
+      .value("GLOBAL", Planner::DuplicateDetection::kGlobal);
+  planner
+      .def(py::init<const Pddl&, Planner::DuplicateDetection>(), "pddl"_a,
+           "duplicate_detection"_a = Planner::DuplicateDetection::kPath,
+           R"pbdoc(
         Planner class to find a state that satisfies the goal condition from the initial state.
 
         Args:
           pddl: Pddl instance.
+          duplicate_detection: How to prune children that revisit a state.
 
         .. seealso:: C++: :symbolic:`symbolic::Planner::Planner`.
        )pbdoc")
-      .def(py::init([](const Pddl& pddl, const StringSet& state) {
-             return Planner(pddl, ParseState(pddl, state));
+      .def(py::init([](const Pddl& pddl, const StringSet& state,
+                       Planner::DuplicateDetection duplicate_detection) {
+             return Planner(pddl, ParseState(pddl, state),
+                            duplicate_detection);
            }),
-           "pddl"_a, "state"_a, R"pbdoc(
+           "pddl"_a, "state"_a,
+           "duplicate_detection"_a = Planner::DuplicateDetection::kPath,
+           R"pbdoc(
         Planner class to find a state that satisfies the goal condition from the given state.
 
         Args:
           pddl: Pddl instance.
           state: State from which to search.
+          duplicate_detection: How to prune children that revisit a state.
 
         .. seealso:: C++: :symbolic:`symbolic::Planner::Planner`.
        )pbdoc")
@@ -607,6 +1049,473 @@ PYBIND11_MODULE(pysymbolic, m) {
         return *it.it;
       });
 
+  // InPlaceDepthFirstSearch
+  py::class_<InPlaceDepthFirstSearch>(m, "InPlaceDepthFirstSearch")
+      .def(py::init([](const Pddl& pddl, const StringSet& state,
+                       size_t max_depth) {
+             return InPlaceDepthFirstSearch(pddl, ParseState(pddl, state),
+                                            max_depth);
+           }),
+           "pddl"_a, "state"_a, "max_depth"_a, py::keep_alive<1, 2>(),
+           R"pbdoc(
+             Depth-first search that applies actions in place and backtracks
+             with an undo log instead of copying states.
+
+             Args:
+                 pddl: Pddl instance.
+                 state: State from which to search.
+                 max_depth: Maximum plan length.
+
+             .. seealso:: C++: :symbolic:`symbolic::InPlaceDepthFirstSearch::InPlaceDepthFirstSearch`.
+           )pbdoc")
+      .def("search", &InPlaceDepthFirstSearch::Search, R"pbdoc(
+             Searches for a plan up to the maximum depth.
+
+             Returns:
+                 List of action calls, or None if no plan was found.
+
+             .. seealso:: C++: :symbolic:`symbolic::InPlaceDepthFirstSearch::Search`.
+           )pbdoc")
+      .def("search_iterative_deepening",
+           &InPlaceDepthFirstSearch::SearchIterativeDeepening, R"pbdoc(
+             Searches with increasing depth limits, which returns a shortest
+             plan.
+
+             Returns:
+                 List of action calls, or None if no plan was found.
+
+             .. seealso:: C++: :symbolic:`symbolic::InPlaceDepthFirstSearch::SearchIterativeDeepening`.
+           )pbdoc")
+      .def_property_readonly("num_generated",
+                             &InPlaceDepthFirstSearch::num_generated);
+
+  // RelaxationHeuristic
+  py::class_<RelaxationHeuristic> relaxation_heuristic(m,
+                                                       "RelaxationHeuristic");
+  py::enum_<RelaxationHeuristic::Type>(relaxation_heuristic, "Type")
+      .value("ADD", RelaxationHeuristic::Type::kAdd)
+      .value("MAX", RelaxationHeuristic::Type::kMax)
+      .value("FF", RelaxationHeuristic::Type::kFF);
+  relaxation_heuristic
+      .def(py::init<const Pddl&, RelaxationHeuristic::Type>(), "pddl"_a,
+           "type"_a, py::keep_alive<1, 2>(), R"pbdoc(
+             Delete relaxation heuristic over the ground actions, which must
+             have been grounded with Pddl.ground().
+
+             Args:
+                 pddl: Pddl instance.
+                 type: Heuristic to compute.
+
+             .. seealso:: C++: :symbolic:`symbolic::RelaxationHeuristic::RelaxationHeuristic`.
+           )pbdoc")
+      .def("__call__", &EvaluateHeuristic<RelaxationHeuristic>, "state"_a,
+           R"pbdoc(
+             Evaluates the heuristic in the given state.
+
+             Returns:
+                 Heuristic value, or None if the goal is relaxed unreachable.
+
+             .. seealso:: C++: :symbolic:`symbolic::RelaxationHeuristic::operator()`.
+           )pbdoc")
+      .def_property_readonly("type", &RelaxationHeuristic::type);
+
+  // LandmarkGraph
+  py::class_<LandmarkGraph>(m, "LandmarkGraph")
+      .def(py::init([](const Pddl& pddl, const StringSet& state) {
+             return LandmarkGraph(pddl, ParseState(pddl, state));
+           }),
+           "pddl"_a, "state"_a, R"pbdoc(
+             Extracts the fact landmarks of the goal from the given state.
+
+             Args:
+                 pddl: Pddl instance with grounded actions.
+                 state: State from which to plan.
+
+             .. seealso:: C++: :symbolic:`symbolic::LandmarkGraph::LandmarkGraph`.
+           )pbdoc")
+      .def_property_readonly("is_reachable", &LandmarkGraph::is_reachable)
+      .def_property_readonly("landmarks", &LandmarkGraph::landmarks)
+      .def_property_readonly("orderings", &LandmarkGraph::orderings);
+
+  // LandmarkCountHeuristic
+  py::class_<LandmarkCountHeuristic>(m, "LandmarkCountHeuristic")
+      .def(py::init<const Pddl&>(), "pddl"_a, py::keep_alive<1, 2>(),
+           R"pbdoc(
+             Counts the landmarks of the goal that are false in a state.
+
+             Args:
+                 pddl: Pddl instance with grounded actions.
+
+             .. seealso:: C++: :symbolic:`symbolic::LandmarkCountHeuristic::LandmarkCountHeuristic`.
+           )pbdoc")
+      .def("__call__", &EvaluateHeuristic<LandmarkCountHeuristic>, "state"_a,
+           R"pbdoc(
+             Evaluates the heuristic in the given state.
+
+             Returns:
+                 Number of false landmarks, or None if the goal is relaxed
+                 unreachable.
+
+             .. seealso:: C++: :symbolic:`symbolic::LandmarkCountHeuristic::operator()`.
+           )pbdoc");
+
+  // PatternDatabase
+  py::class_<PatternDatabase>(m, "PatternDatabase")
+      .def(py::init<const Pddl&, const std::vector<size_t>&>(), "pddl"_a,
+           "pattern"_a, py::keep_alive<1, 2>(), R"pbdoc(
+             Builds the pattern database over the given propositions.
+
+             Args:
+                 pddl: Pddl instance with grounded actions.
+                 pattern: StateIndex indices of the pattern propositions.
+
+             .. seealso:: C++: :symbolic:`symbolic::PatternDatabase::PatternDatabase`.
+           )pbdoc")
+      .def(py::init([](const Pddl& pddl, const StringVector& atoms) {
+             return PatternDatabase(
+                 pddl, PatternDatabase::CreatePattern(pddl, atoms));
+           }),
+           "pddl"_a, "atoms"_a, py::keep_alive<1, 2>(), R"pbdoc(
+             Builds the pattern database over predicates and propositions.
+
+             Args:
+                 pddl: Pddl instance with grounded actions.
+                 atoms: Predicate names or propositions.
+
+             .. seealso:: C++: :symbolic:`symbolic::PatternDatabase::CreatePattern`.
+           )pbdoc")
+      .def_static("create_pattern", &PatternDatabase::CreatePattern, "pddl"_a,
+                  "atoms"_a)
+      .def_static("load", &PatternDatabase::Load, "pddl"_a, "filename"_a,
+                  py::keep_alive<0, 1>())
+      .def("save", &PatternDatabase::Save, "filename"_a)
+      .def("__call__", &EvaluateHeuristic<PatternDatabase>, "state"_a)
+      .def_property_readonly("pattern", &PatternDatabase::pattern)
+      .def_property_readonly("distances", &PatternDatabase::distances);
+
+  // PatternDatabaseHeuristic
+  py::class_<PatternDatabaseHeuristic> pdb_heuristic(
+      m, "PatternDatabaseHeuristic");
+  py::enum_<PatternDatabaseHeuristic::Combination>(pdb_heuristic,
+                                                   "Combination")
+      .value("SUM", PatternDatabaseHeuristic::Combination::kSum)
+      .value("MAX", PatternDatabaseHeuristic::Combination::kMax);
+  pdb_heuristic
+      .def(py::init<std::vector<PatternDatabase>,
+                    PatternDatabaseHeuristic::Combination>(),
+           "pdbs"_a, "combination"_a, R"pbdoc(
+             Admissible combination of pattern databases.
+
+             Args:
+                 pdbs: Pattern databases of the same Pddl.
+                 combination: Sum or maximum of the distances.
+
+             .. seealso:: C++: :symbolic:`symbolic::PatternDatabaseHeuristic::PatternDatabaseHeuristic`.
+           )pbdoc")
+      .def("__call__", &EvaluateHeuristic<PatternDatabaseHeuristic>, "state"_a)
+      .def_property_readonly("pdbs", &PatternDatabaseHeuristic::pdbs)
+      .def_property_readonly("combination",
+                             &PatternDatabaseHeuristic::combination);
+
+  // BestFirstSearch
+  py::class_<BestFirstSearch::Statistics>(m, "BestFirstSearchStatistics")
+      .def_readonly("num_expanded", &BestFirstSearch::Statistics::num_expanded)
+      .def_readonly("num_generated",
+                    &BestFirstSearch::Statistics::num_generated)
+      .def_readonly("num_reopened", &BestFirstSearch::Statistics::num_reopened);
+  py::class_<BestFirstSearch>(m, "BestFirstSearch")
+      .def(py::init(&CreateBestFirstSearch<RelaxationHeuristic>), "pddl"_a,
+           "heuristic"_a, "weight"_a = 1., py::keep_alive<1, 2>(),
+           py::keep_alive<1, 3>(), R"pbdoc(
+             Best-first search that expands the node with the lowest
+             g + weight * h. With weight 1 this is A*.
+
+             Args:
+                 pddl: Pddl instance with grounded actions.
+                 heuristic: Heuristic to guide the search.
+                 weight: Weight of the heuristic.
+
+             .. seealso:: C++: :symbolic:`symbolic::BestFirstSearch::BestFirstSearch`.
+           )pbdoc")
+      .def(py::init(&CreateBestFirstSearch<LandmarkCountHeuristic>), "pddl"_a,
+           "heuristic"_a, "weight"_a = 1., py::keep_alive<1, 2>(),
+           py::keep_alive<1, 3>())
+      .def(py::init(&CreateBestFirstSearch<PatternDatabaseHeuristic>),
+           "pddl"_a, "heuristic"_a, "weight"_a = 1., py::keep_alive<1, 2>(),
+           py::keep_alive<1, 3>())
+      .def(
+          "search",
+          [](BestFirstSearch& search, const StringSet& state,
+             size_t max_expansions) {
+            return search.Search(ParseState(search.pddl(), state),
+                                 max_expansions);
+          },
+          "state"_a, "max_expansions"_a = 0,
+          py::call_guard<py::gil_scoped_release>(), R"pbdoc(
+             Searches for a plan from the given state.
+
+             Args:
+                 state: State from which to search.
+                 max_expansions: Maximum number of expansions, or 0 for no
+                     limit.
+
+             Returns:
+                 List of action calls, or None if no plan was found.
+
+             .. seealso:: C++: :symbolic:`symbolic::BestFirstSearch::Search`.
+           )pbdoc")
+      .def_property_readonly("statistics", &BestFirstSearch::statistics);
+
+  // HashDistributedAStar
+  py::class_<HashDistributedAStar::Statistics>(m,
+                                               "HashDistributedAStarStatistics")
+      .def_readonly("num_expanded",
+                    &HashDistributedAStar::Statistics::num_expanded)
+      .def_readonly("num_generated",
+                    &HashDistributedAStar::Statistics::num_generated)
+      .def_readonly("num_sent", &HashDistributedAStar::Statistics::num_sent);
+  py::class_<HashDistributedAStar>(m, "HashDistributedAStar")
+      .def(py::init(&CreateHashDistributedAStar<RelaxationHeuristic>),
+           "pddl"_a, "heuristic"_a, "pool"_a, py::keep_alive<1, 2>(),
+           py::keep_alive<1, 3>(), py::keep_alive<1, 4>(), R"pbdoc(
+             Hash-distributed A* whose workers own the states that hash to
+             them.
+
+             Args:
+                 pddl: Pddl instance with grounded actions.
+                 heuristic: Heuristic to guide the search.
+                 pool: Thread pool whose threads run the workers.
+
+             .. seealso:: C++: :symbolic:`symbolic::HashDistributedAStar::HashDistributedAStar`.
+           )pbdoc")
+      .def(py::init(&CreateHashDistributedAStar<LandmarkCountHeuristic>),
+           "pddl"_a, "heuristic"_a, "pool"_a, py::keep_alive<1, 2>(),
+           py::keep_alive<1, 3>(), py::keep_alive<1, 4>())
+      .def(py::init(&CreateHashDistributedAStar<PatternDatabaseHeuristic>),
+           "pddl"_a, "heuristic"_a, "pool"_a, py::keep_alive<1, 2>(),
+           py::keep_alive<1, 3>(), py::keep_alive<1, 4>())
+      .def(
+          "search",
+          [](HashDistributedAStar& search, const StringSet& state,
+             size_t max_expansions) {
+            return search.Search(ParseState(search.pddl(), state),
+                                 max_expansions);
+          },
+          "state"_a, "max_expansions"_a = 0,
+          py::call_guard<py::gil_scoped_release>(), R"pbdoc(
+             Searches for an optimal plan from the given state.
+
+             Args:
+                 state: State from which to search.
+                 max_expansions: Maximum number of expansions, or 0 for no
+                     limit.
+
+             Returns:
+                 List of action calls, or None if no plan was found.
+
+             .. seealso:: C++: :symbolic:`symbolic::HashDistributedAStar::Search`.
+           )pbdoc")
+      .def_property_readonly("statistics", &HashDistributedAStar::statistics);
+
+  // IterativeDeepeningSearch
+  py::class_<IterativeDeepeningSearch::Statistics>(
+      m, "IterativeDeepeningSearchStatistics")
+      .def_readonly("num_expanded",
+                    &IterativeDeepeningSearch::Statistics::num_expanded)
+      .def_readonly("num_generated",
+                    &IterativeDeepeningSearch::Statistics::num_generated)
+      .def_readonly("num_pruned",
+                    &IterativeDeepeningSearch::Statistics::num_pruned)
+      .def_readonly("depth", &IterativeDeepeningSearch::Statistics::depth)
+      .def_readonly("is_aborted",
+                    &IterativeDeepeningSearch::Statistics::is_aborted);
+  py::class_<IterativeDeepeningSearch>(m, "IterativeDeepeningSearch")
+      .def(py::init<const Pddl&, size_t>(), "pddl"_a,
+           "table_size"_a = IterativeDeepeningSearch::kDefaultTableSize,
+           py::keep_alive<1, 2>(), R"pbdoc(
+             Iterative deepening search with a fixed-size transposition table.
+
+             Args:
+                 pddl: Pddl instance with grounded actions.
+                 table_size: Number of entries in the transposition table.
+
+             .. seealso:: C++: :symbolic:`symbolic::IterativeDeepeningSearch::IterativeDeepeningSearch`.
+           )pbdoc")
+      .def(
+          "search",
+          [](IterativeDeepeningSearch& search, const StringSet& state,
+             size_t max_depth, size_t max_expansions, double timeout) {
+            return search.Search(
+                ParseState(search.pddl(), state), max_depth, max_expansions,
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::duration<double>(timeout)));
+          },
+          "state"_a, "max_depth"_a, "max_expansions"_a = 0, "timeout"_a = 0.,
+          py::call_guard<py::gil_scoped_release>(), R"pbdoc(
+             Searches with increasing depth limits for a shortest plan.
+
+             Args:
+                 state: State from which to search.
+                 max_depth: Maximum plan length.
+                 max_expansions: Maximum number of expansions, or 0 for no
+                     limit.
+                 timeout: Maximum search time in seconds, or 0 for no limit.
+
+             Returns:
+                 List of action calls, or None if no plan was found.
+
+             .. seealso:: C++: :symbolic:`symbolic::IterativeDeepeningSearch::Search`.
+           )pbdoc")
+      .def_property_readonly("table_size",
+                             &IterativeDeepeningSearch::table_size)
+      .def_property_readonly("statistics",
+                             &IterativeDeepeningSearch::statistics);
+
+  // ParallelBreadthFirstSearch
+  py::class_<ParallelBreadthFirstSearch::Statistics>(
+      m, "ParallelBreadthFirstSearchStatistics")
+      .def_readonly("num_expanded",
+                    &ParallelBreadthFirstSearch::Statistics::num_expanded)
+      .def_readonly("num_generated",
+                    &ParallelBreadthFirstSearch::Statistics::num_generated)
+      .def_readonly("depth", &ParallelBreadthFirstSearch::Statistics::depth);
+  py::class_<ParallelBreadthFirstSearch>(m, "ParallelBreadthFirstSearch")
+      .def(py::init<const Pddl&, ThreadPool*>(), "pddl"_a, "pool"_a,
+           py::keep_alive<1, 2>(), py::keep_alive<1, 3>(), R"pbdoc(
+             Breadth-first search that expands each depth layer across the
+             thread pool.
+
+             Args:
+                 pddl: Pddl instance with grounded actions.
+                 pool: Thread pool that expands the layers.
+
+             .. seealso:: C++: :symbolic:`symbolic::ParallelBreadthFirstSearch::ParallelBreadthFirstSearch`.
+           )pbdoc")
+      .def(
+          "search",
+          [](ParallelBreadthFirstSearch& search, const StringSet& state,
+             size_t max_depth) {
+            return search.Search(ParseState(search.pddl(), state), max_depth);
+          },
+          "state"_a, "max_depth"_a = 0,
+          py::call_guard<py::gil_scoped_release>(), R"pbdoc(
+             Searches for a shortest plan from the given state.
+
+             Args:
+                 state: State from which to search.
+                 max_depth: Maximum plan length, or 0 for no limit.
+
+             Returns:
+                 List of action calls, or None if no plan was found.
+
+             .. seealso:: C++: :symbolic:`symbolic::ParallelBreadthFirstSearch::Search`.
+           )pbdoc")
+      .def_property_readonly("statistics",
+                             &ParallelBreadthFirstSearch::statistics);
+
+  // ParallelDepthFirstSearch
+  py::class_<ParallelDepthFirstSearch::Statistics>(
+      m, "ParallelDepthFirstSearchStatistics")
+      .def_readonly("num_expanded",
+                    &ParallelDepthFirstSearch::Statistics::num_expanded)
+      .def_readonly("num_generated",
+                    &ParallelDepthFirstSearch::Statistics::num_generated)
+      .def_readonly("num_stolen",
+                    &ParallelDepthFirstSearch::Statistics::num_stolen);
+  py::class_<ParallelDepthFirstSearch>(m, "ParallelDepthFirstSearch")
+      .def(py::init<const Pddl&, ThreadPool*>(), "pddl"_a, "pool"_a,
+           py::keep_alive<1, 2>(), py::keep_alive<1, 3>(), R"pbdoc(
+             Depth-limited search that splits subtrees across the thread pool
+             with work stealing.
+
+             Args:
+                 pddl: Pddl instance with grounded actions.
+                 pool: Thread pool whose threads run the searches.
+
+             .. seealso:: C++: :symbolic:`symbolic::ParallelDepthFirstSearch::ParallelDepthFirstSearch`.
+           )pbdoc")
+      .def(
+          "search",
+          [](ParallelDepthFirstSearch& search, const StringSet& state,
+             size_t max_depth) {
+            return search.Search(ParseState(search.pddl(), state), max_depth);
+          },
+          "state"_a, "max_depth"_a, py::call_guard<py::gil_scoped_release>(),
+          R"pbdoc(
+             Searches for any plan up to the maximum depth.
+
+             Args:
+                 state: State from which to search.
+                 max_depth: Maximum plan length.
+
+             Returns:
+                 List of action calls, or None if no plan was found.
+
+             .. seealso:: C++: :symbolic:`symbolic::ParallelDepthFirstSearch::Search`.
+           )pbdoc")
+      .def(
+          "search_iterative_deepening",
+          [](ParallelDepthFirstSearch& search, const StringSet& state,
+             size_t max_depth) {
+            return search.SearchIterativeDeepening(
+                ParseState(search.pddl(), state), max_depth);
+          },
+          "state"_a, "max_depth"_a, py::call_guard<py::gil_scoped_release>(),
+          R"pbdoc(
+             Searches with increasing depth limits for a shortest plan.
+
+             Args:
+                 state: State from which to search.
+                 max_depth: Maximum plan length.
+
+             Returns:
+                 List of action calls, or None if no plan was found.
+
+             .. seealso:: C++: :symbolic:`symbolic::ParallelDepthFirstSearch::SearchIterativeDeepening`.
+           )pbdoc")
+      .def_property_readonly("statistics",
+                             &ParallelDepthFirstSearch::statistics);
+
+  // RegressionSearch
+  py::class_<RegressionSearch::Statistics>(m, "RegressionSearchStatistics")
+      .def_readonly("num_expanded",
+                    &RegressionSearch::Statistics::num_expanded)
+      .def_readonly("num_generated",
+                    &RegressionSearch::Statistics::num_generated)
+      .def_readonly("num_subsumed",
+                    &RegressionSearch::Statistics::num_subsumed);
+  py::class_<RegressionSearch>(m, "RegressionSearch")
+      .def(py::init<const Pddl&>(), "pddl"_a, py::keep_alive<1, 2>(),
+           R"pbdoc(
+             Breadth-first search backward from the goal over partial states.
+
+             Args:
+                 pddl: Pddl instance.
+
+             .. seealso:: C++: :symbolic:`symbolic::RegressionSearch::RegressionSearch`.
+           )pbdoc")
+      .def(
+          "search",
+          [](RegressionSearch& search, const StringSet& state,
+             size_t max_depth) {
+            return search.Search(ParseState(search.pddl(), state), max_depth);
+          },
+          "state"_a, "max_depth"_a = 0,
+          py::call_guard<py::gil_scoped_release>(), R"pbdoc(
+             Searches backward from the goal for a shortest plan from the given
+             state.
+
+             Args:
+                 state: State from which to search.
+                 max_depth: Maximum plan length, or 0 for no limit.
+
+             Returns:
+                 List of action calls, or None if no plan was found.
+
+             .. seealso:: C++: :symbolic:`symbolic::RegressionSearch::Search`.
+           )pbdoc")
+      .def_property_readonly("statistics", &RegressionSearch::statistics);
+
   py::class_<DisjunctiveFormula>(m, "DisjunctiveFormula")
       .def_readonly("conjunctions", &DisjunctiveFormula::conjunctions)
       .def_static("normalize_goal", &DisjunctiveFormula::NormalizeGoal,
@@ -0,0 +1,157 @@
+/**
+ * reachability.cc
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#include "symbolic/reachability.h"
+
+#include <VAL/ptree.h>
+
+#include <algorithm>  // std::find, std::sort, std::unique
+#include <set>        // std::set
+#include <string>     // std::string
+
+#include "symbolic/pddl.h"
+#include "utils/doctest.h"
+
+namespace {
+
+using ::symbolic::GroundAction;
+using ::symbolic::GroundConditionalEffect;
+
+/**
+ * Ground action or one of its conditional effects, which fires once all of
+ * its positive preconditions have been reached.
+ */
+struct Unit {
+  size_t id_action;
+  bool is_action;
+  const std::vector<size_t>* add_effects;
+  size_t num_unreached;
+};
+
+std::vector<size_t> Union(const std::vector<size_t>& a,
+                          const std::vector<size_t>& b) {
+  std::vector<size_t> c = a;
+  c.insert(c.end(), b.begin(), b.end());
+  std::sort(c.begin(), c.end());
+  c.erase(std::unique(c.begin(), c.end()), c.end());
+  return c;
+}
+
+}  // namespace
+
+namespace symbolic {
+
+Reachability Reachability::Compute(const Pddl& pddl,
+                                   const std::vector<GroundAction>& actions) {
+  const StateIndex& state_index = pddl.state_index();
+  std::vector<bool> is_reached(state_index.size(), false);
+  std::vector<size_t> queue;
+  const auto Reach = [&is_reached, &queue](size_t idx_prop) {
+    if (is_reached[idx_prop]) return;
+    is_reached[idx_prop] = true;
+    queue.push_back(idx_prop);
+  };
+
+  // Propositions that aren't controlled by the ground actions.
+  std::set<std::string> unconstrained;
+  for (const DerivedPredicate& pred : pddl.derived_predicates()) {
+    unconstrained.insert(pred.name());
+  }
+  for (const std::shared_ptr<Axiom>& axiom : pddl.axioms()) {
+    AddEffectPredicates(axiom->postconditions(), &unconstrained);
+  }
+  if (!unconstrained.empty()) {
+    for (size_t i = 0; i < state_index.size(); i++) {
+      if (unconstrained.count(state_index.GetProposition(i).name()) > 0) {
+        Reach(i);
+      }
+    }
+  }
+
+  const StateIndex::IndexedState s0 =
+      state_index.GetIndexedState(pddl.initial_state());
+  for (size_t i = 0; i < state_index.size(); i++) {
+    if (s0[i]) Reach(i);
+  }
+
+  // Create units and index them by their positive preconditions.
+  std::vector<Unit> units;
+  std::vector<std::vector<size_t>> watchers(state_index.size());
+  const auto AddUnit = [&units, &watchers](size_t id_action, bool is_action,
+                                           const std::vector<size_t>& pre_pos,
+                                           const std::vector<size_t>& add) {
+    const size_t idx_unit = units.size();
+    units.push_back({id_action, is_action, &add, pre_pos.size()});
+    for (const size_t idx_prop : pre_pos) {
+      watchers[idx_prop].push_back(idx_unit);
+    }
+  };
+  for (const GroundAction& action : actions) {
+    AddUnit(action.id(), true, action.pre_pos(), action.add_effects());
+    for (const GroundConditionalEffect& effect : action.conditional_effects()) {
+      AddUnit(action.id(), false, Union(action.pre_pos(), effect.pre_pos),
+              effect.add_effects);
+    }
+  }
+
+  std::vector<bool> is_action_reached(actions.size(), false);
+  const auto Fire = [&is_action_reached, &Reach](const Unit& unit) {
+    if (unit.is_action) is_action_reached[unit.id_action] = true;
+    for (const size_t idx_prop : *unit.add_effects) Reach(idx_prop);
+  };
+
+  // Fire units without positive preconditions.
+  for (const Unit& unit : units) {
+    if (unit.num_unreached == 0) Fire(unit);
+  }
+
+  // Propagate reached propositions until the fixpoint.
+  for (size_t i = 0; i < queue.size(); i++) {
+    for (const size_t idx_unit : watchers[queue[i]]) {
+      Unit& unit = units[idx_unit];
+      if (--unit.num_unreached == 0) Fire(unit);
+    }
+  }
+
+  Reachability reachability;
+  for (size_t i = 0; i < is_reached.size(); i++) {
+    if (is_reached[i]) reachability.propositions.push_back(i);
+  }
+  for (size_t i = 0; i < is_action_reached.size(); i++) {
+    if (is_action_reached[i]) reachability.actions.push_back(i);
+  }
+  return reachability;
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "Reachability.Compute") {
+  const std::vector<GroundAction>& actions = pddl.Ground();
+  const Reachability reachability = Reachability::Compute(pddl, actions);
+
+  const auto IsReached = [this, &reachability](const std::string& str_prop) {
+    const size_t idx_prop =
+        pddl.state_index().GetPropositionIndex(Proposition(pddl, str_prop));
+    const std::vector<size_t>& props = reachability.propositions;
+    return std::find(props.begin(), props.end(), idx_prop) != props.end();
+  };
+
+  // The box reaches the workspace by pushing it with the hook.
+  REQUIRE(IsReached("inworkspace(box)"));
+  REQUIRE(IsReached("on(box, shelf)"));
+  REQUIRE(!IsReached("on(hook, hook)"));
+
+  // Every ground action valid in the initial state is reachable.
+  const std::vector<size_t> applicable =
+      pddl.ListApplicableGroundActions(pddl.initial_state());
+  for (const size_t id : applicable) {
+    REQUIRE(std::find(reachability.actions.begin(), reachability.actions.end(),
+                      id) != reachability.actions.end());
+  }
+}
+
+}  // namespace symbolic
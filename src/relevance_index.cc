@@ -0,0 +1,205 @@
+/**
+ * relevance_index.cc
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#include "symbolic/relevance_index.h"
+
+#include <VAL/ptree.h>
+
+#include "symbolic/pddl.h"
+#include "utils/doctest.h"
+
+namespace {
+
+using ::symbolic::GroundAction;
+using ::symbolic::GroundConditionalEffect;
+using ::symbolic::RelevantActions;
+
+using PredicateMap = std::unordered_map<std::string, RelevantActions>;
+
+/**
+ * Appends the action unless it was the last one appended. Actions are visited
+ * in increasing order, so this keeps the lists sorted and unique.
+ */
+void Insert(size_t idx_action, std::vector<size_t>* actions) {
+  if (actions->empty() || actions->back() != idx_action) {
+    actions->push_back(idx_action);
+  }
+}
+
+void AddPreconditions(const VAL::goal* symbol, bool is_pos, size_t idx_action,
+                      PredicateMap* predicates) {
+  if (symbol == nullptr) return;
+
+  const auto* simple_goal = dynamic_cast<const VAL::simple_goal*>(symbol);
+  if (simple_goal != nullptr) {
+    const std::string& name_predicate =
+        simple_goal->getProp()->head->getNameRef();
+    if (name_predicate == "=") return;
+    RelevantActions& relevant = (*predicates)[name_predicate];
+    Insert(idx_action, is_pos ? &relevant.pre_pos : &relevant.pre_neg);
+    return;
+  }
+
+  const auto* neg_goal = dynamic_cast<const VAL::neg_goal*>(symbol);
+  if (neg_goal != nullptr) {
+    AddPreconditions(neg_goal->getGoal(), !is_pos, idx_action, predicates);
+    return;
+  }
+
+  const auto* conj_goal = dynamic_cast<const VAL::conj_goal*>(symbol);
+  if (conj_goal != nullptr) {
+    for (const VAL::goal* goal : *conj_goal->getGoals()) {
+      AddPreconditions(goal, is_pos, idx_action, predicates);
+    }
+    return;
+  }
+
+  const auto* disj_goal = dynamic_cast<const VAL::disj_goal*>(symbol);
+  if (disj_goal != nullptr) {
+    for (const VAL::goal* goal : *disj_goal->getGoals()) {
+      AddPreconditions(goal, is_pos, idx_action, predicates);
+    }
+    return;
+  }
+
+  const auto* qfied_goal = dynamic_cast<const VAL::qfied_goal*>(symbol);
+  if (qfied_goal != nullptr) {
+    AddPreconditions(qfied_goal->getGoal(), is_pos, idx_action, predicates);
+    return;
+  }
+
+  // (a => b) is equivalent to (not a or b).
+  const auto* imply_goal = dynamic_cast<const VAL::imply_goal*>(symbol);
+  if (imply_goal != nullptr) {
+    AddPreconditions(imply_goal->getAntecedent(), !is_pos, idx_action,
+                     predicates);
+    AddPreconditions(imply_goal->getConsequent(), is_pos, idx_action,
+                     predicates);
+  }
+}
+
+void AddEffects(const VAL::effect_lists* effects, size_t idx_action,
+                PredicateMap* predicates) {
+  for (const VAL::simple_effect* effect : effects->add_effects) {
+    Insert(idx_action, &(*predicates)[effect->prop->head->getNameRef()].add);
+  }
+  for (const VAL::simple_effect* effect : effects->del_effects) {
+    Insert(idx_action, &(*predicates)[effect->prop->head->getNameRef()].del);
+  }
+  for (const VAL::forall_effect* effect : effects->forall_effects) {
+    AddEffects(effect->getEffects(), idx_action, predicates);
+  }
+  for (const VAL::cond_effect* effect : effects->cond_effects) {
+    AddEffects(effect->getEffects(), idx_action, predicates);
+  }
+}
+
+void AddGroundEffects(const std::vector<size_t>& add_effects,
+                      const std::vector<size_t>& del_effects, size_t id_action,
+                      std::vector<RelevantActions>* propositions) {
+  for (const size_t idx_prop : add_effects) {
+    Insert(id_action, &(*propositions)[idx_prop].add);
+  }
+  for (const size_t idx_prop : del_effects) {
+    Insert(id_action, &(*propositions)[idx_prop].del);
+  }
+}
+
+}  // namespace
+
+namespace symbolic {
+
+RelevanceIndex::RelevanceIndex(const std::vector<Action>& actions) {
+  for (size_t i = 0; i < actions.size(); i++) {
+    const Action& action = actions[i];
+    AddPreconditions(action.preconditions().symbol(), true, i, &predicates_);
+    if (action.postconditions() != nullptr) {
+      AddEffects(action.postconditions(), i, &predicates_);
+    }
+  }
+}
+
+void RelevanceIndex::IndexGroundActions(
+    size_t num_propositions, const std::vector<GroundAction>& actions) {
+  propositions_.assign(num_propositions, RelevantActions());
+  for (const GroundAction& action : actions) {
+    const size_t id = action.id();
+    for (const size_t idx_prop : action.pre_pos()) {
+      Insert(id, &propositions_[idx_prop].pre_pos);
+    }
+    for (const size_t idx_prop : action.pre_neg()) {
+      Insert(id, &propositions_[idx_prop].pre_neg);
+    }
+    AddGroundEffects(action.add_effects(), action.del_effects(), id,
+                     &propositions_);
+    for (const GroundConditionalEffect& effect : action.conditional_effects()) {
+      AddGroundEffects(effect.add_effects, effect.del_effects, id,
+                       &propositions_);
+    }
+  }
+}
+
+const RelevantActions& RelevanceIndex::predicate(
+    const std::string& name_predicate) const {
+  static const RelevantActions kNone;
+  const auto it = predicates_.find(name_predicate);
+  return it == predicates_.end() ? kNone : it->second;
+}
+
+void AddEffectPredicates(const VAL::effect_lists* effects,
+                         std::set<std::string>* predicates) {
+  for (const VAL::simple_effect* effect : effects->add_effects) {
+    predicates->insert(effect->prop->head->getNameRef());
+  }
+  for (const VAL::simple_effect* effect : effects->del_effects) {
+    predicates->insert(effect->prop->head->getNameRef());
+  }
+  for (const VAL::forall_effect* effect : effects->forall_effects) {
+    AddEffectPredicates(effect->getEffects(), predicates);
+  }
+  for (const VAL::cond_effect* effect : effects->cond_effects) {
+    AddEffectPredicates(effect->getEffects(), predicates);
+  }
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "RelevanceIndex.predicate") {
+  // Actions are pick (0), place (1) and push (2).
+  const RelevanceIndex& index = pddl.relevance_index();
+  const RelevantActions& inhand = index.predicate("inhand");
+  REQUIRE((inhand.add == std::vector<size_t>{0}));
+  REQUIRE((inhand.del == std::vector<size_t>{1}));
+  REQUIRE((inhand.pre_pos == std::vector<size_t>{1, 2}));
+  REQUIRE((inhand.pre_neg == std::vector<size_t>{0}));
+
+  const RelevantActions& inworkspace = index.predicate("inworkspace");
+  REQUIRE((inworkspace.add == std::vector<size_t>{2}));
+  REQUIRE(inworkspace.del.empty());
+  REQUIRE((inworkspace.pre_pos == std::vector<size_t>{0, 1, 2}));
+
+  REQUIRE(index.predicate("throwable").add.empty());
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "RelevanceIndex.proposition") {
+  const std::vector<GroundAction>& actions = pddl.Ground();
+  const RelevanceIndex& index = pddl.relevance_index();
+  REQUIRE(index.propositions().size() == pddl.state_index().size());
+
+  const size_t idx_prop =
+      pddl.state_index().GetPropositionIndex(Proposition(pddl, "inhand(hook)"));
+  const RelevantActions& relevant = index.proposition(idx_prop);
+  for (const size_t id : relevant.add) {
+    REQUIRE(actions[id].to_string() == "pick(hook)");
+  }
+  REQUIRE(relevant.add.size() == 1);
+  for (const size_t id : relevant.pre_pos) {
+    REQUIRE(actions[id].arguments().front().name() == "hook");
+  }
+}
+
+}  // namespace symbolic
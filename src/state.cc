@@ -9,8 +9,10 @@
 
 #include "symbolic/state.h"
 
-#include <algorithm>  // std::lower_bound, std::sort
-#include <cassert>    // assert
+#include <algorithm>    // std::lower_bound, std::sort
+#include <cassert>      // assert
+#include <string_view>  // std::string_view
+#include <utility>      // std::move
 
 #include "symbolic/pddl.h"
 #include "symbolic/utils/unique_vector.h"
@@ -144,14 +146,25 @@ StateIndex::StateIndex(const std::vector<Predicate>& predicates, bool use_cache)
       predicates_(predicates),
       idx_predicate_group_(PredicateCumSum(predicates_)),
       idx_predicates_(PredicateIndices(predicates_)),
-      use_cache_(use_cache) {}
+      use_cache_(use_cache) {
+  if (!use_cache_) return;
+
+  // Fill the cache once so that it is never modified by lookups.
+  cache_propositions_.reserve(size());
+  cache_idx_propositions_.reserve(size());
+  for (const Predicate& pred : predicates_) {
+    const ParameterGenerator& param_gen = pred.parameter_generator();
+    for (size_t idx_args = 0; idx_args < param_gen.size(); idx_args++) {
+      Proposition prop(pred.name(), param_gen[idx_args]);
+      cache_idx_propositions_.emplace(prop, cache_propositions_.size());
+      cache_propositions_.push_back(std::move(prop));
+    }
+  }
+}
 
 Proposition StateIndex::GetProposition(size_t idx_proposition) const {
   // Check cache
-  if (use_cache_ &&
-      cache_propositions_.find(idx_proposition) != cache_propositions_.end()) {
-    return cache_propositions_.at(idx_proposition);
-  }
+  if (use_cache_) return cache_propositions_[idx_proposition];
 
   // Find index of predicate through bisection
   // std::lower_bound returns first element >= value. Get first element > value
@@ -170,18 +183,13 @@ Proposition StateIndex::GetProposition(size_t idx_proposition) const {
   const Predicate& pred = predicates_[idx_pred];
   std::vector<Object> args = pred.parameter_generator()[idx_args];
 
-  // Cache results
-  if (use_cache_) {
-    cache_propositions_[idx_proposition] = Proposition(pred.name(), args);
-  }
-
   return Proposition(pred.name(), std::move(args));
 }
 
 size_t StateIndex::GetPropositionIndex(const Proposition& prop) const {
   // Check cache
   if (use_cache_) {
-    const auto it = cache_idx_propositions_.find(prop.to_string());
+    const auto it = cache_idx_propositions_.find(prop);
     if (it != cache_idx_propositions_.end()) {
       return it->second;
     }
@@ -198,10 +206,6 @@ size_t StateIndex::GetPropositionIndex(const Proposition& prop) const {
 
   const size_t idx_proposition = idx_predicate_group_[idx_pred] + idx_args;
 
-  // Cache results
-  if (use_cache_) {
-    cache_idx_propositions_[prop.to_string()] = idx_proposition;
-  }
   return idx_proposition;
 }
 
@@ -231,6 +235,13 @@ StateIndex::IndexedState StateIndex::GetIndexedState(const State& state) const {
   return indexed_state;
 }
 
+size_t StateIndex::IndexedStateHash::operator()(
+    const IndexedState& state) const noexcept {
+  const std::string_view bytes(reinterpret_cast<const char*>(state.data()),
+                               state.size() * sizeof(bool));
+  return std::hash<std::string_view>{}(bytes);
+}
+
 }  // namespace symbolic
 
 namespace {
@@ -0,0 +1,151 @@
+/**
+ * successor_generator.cc
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#include "symbolic/successor_generator.h"
+
+#include <algorithm>  // std::min, std::sort
+#include <limits>     // std::numeric_limits
+#include <utility>    // std::move, std::pair
+
+#include "symbolic/pddl.h"
+#include "utils/doctest.h"
+
+namespace {
+
+// Precondition literal (proposition index, value).
+using Literal = std::pair<size_t, bool>;
+
+// Ground action id and position of its next untested precondition literal.
+using ActionCursor = std::pair<size_t, size_t>;
+
+}  // namespace
+
+namespace symbolic {
+
+SuccessorGenerator::SuccessorGenerator(
+    const std::vector<GroundAction>& actions) {
+  // Sort the precondition literals of each action by proposition index.
+  std::vector<std::vector<Literal>> preconditions;
+  preconditions.reserve(actions.size());
+  for (const GroundAction& action : actions) {
+    std::vector<Literal> pre;
+    pre.reserve(action.pre_pos().size() + action.pre_neg().size());
+    for (const size_t idx_prop : action.pre_pos()) {
+      pre.emplace_back(idx_prop, true);
+    }
+    for (const size_t idx_prop : action.pre_neg()) {
+      pre.emplace_back(idx_prop, false);
+    }
+    std::sort(pre.begin(), pre.end());
+    preconditions.push_back(std::move(pre));
+  }
+
+  // Build the tree with an explicit stack to avoid deep recursion.
+  std::vector<std::pair<size_t, std::vector<ActionCursor>>> stack;
+  std::vector<ActionCursor> root;
+  root.reserve(actions.size());
+  for (size_t i = 0; i < actions.size(); i++) root.emplace_back(i, 0);
+  nodes_.emplace_back();
+  stack.emplace_back(0, std::move(root));
+
+  while (!stack.empty()) {
+    const size_t idx_node = stack.back().first;
+    const std::vector<ActionCursor> cursors = std::move(stack.back().second);
+    stack.pop_back();
+
+    // Store the actions whose preconditions have all been tested.
+    std::vector<ActionCursor> remaining;
+    nodes_[idx_node].idx_actions = actions_.size();
+    size_t idx_prop = std::numeric_limits<size_t>::max();
+    for (const ActionCursor& cursor : cursors) {
+      const std::vector<Literal>& pre = preconditions[cursor.first];
+      if (cursor.second == pre.size()) {
+        actions_.push_back(cursor.first);
+        continue;
+      }
+      idx_prop = std::min(idx_prop, pre[cursor.second].first);
+      remaining.push_back(cursor);
+    }
+    nodes_[idx_node].num_actions =
+        actions_.size() - nodes_[idx_node].idx_actions;
+    if (remaining.empty()) continue;
+
+    // Split the remaining actions on the smallest untested proposition.
+    std::vector<ActionCursor> cursors_true;
+    std::vector<ActionCursor> cursors_false;
+    std::vector<ActionCursor> cursors_dont_care;
+    for (const ActionCursor& cursor : remaining) {
+      const Literal& literal = preconditions[cursor.first][cursor.second];
+      if (literal.first != idx_prop) {
+        cursors_dont_care.push_back(cursor);
+      } else if (literal.second) {
+        cursors_true.emplace_back(cursor.first, cursor.second + 1);
+      } else {
+        cursors_false.emplace_back(cursor.first, cursor.second + 1);
+      }
+    }
+
+    nodes_[idx_node].idx_prop = idx_prop;
+    const auto AddChild = [this, &stack](std::vector<ActionCursor>&& cursors) {
+      if (cursors.empty()) return -1;
+      const int idx_child = static_cast<int>(nodes_.size());
+      nodes_.emplace_back();
+      stack.emplace_back(idx_child, std::move(cursors));
+      return idx_child;
+    };
+    const int idx_true = AddChild(std::move(cursors_true));
+    const int idx_false = AddChild(std::move(cursors_false));
+    const int idx_dont_care = AddChild(std::move(cursors_dont_care));
+    nodes_[idx_node].idx_true = idx_true;
+    nodes_[idx_node].idx_false = idx_false;
+    nodes_[idx_node].idx_dont_care = idx_dont_care;
+  }
+}
+
+std::vector<size_t> SuccessorGenerator::GetApplicableActions(
+    const StateIndex::IndexedState& state) const {
+  std::vector<size_t> applicable;
+  if (nodes_.empty()) return applicable;
+
+  std::vector<int> stack = {0};
+  while (!stack.empty()) {
+    const Node& node = nodes_[stack.back()];
+    stack.pop_back();
+
+    applicable.insert(applicable.end(), actions_.begin() + node.idx_actions,
+                      actions_.begin() + node.idx_actions + node.num_actions);
+
+    if (node.idx_dont_care >= 0) stack.push_back(node.idx_dont_care);
+    if (node.idx_true < 0 && node.idx_false < 0) continue;
+    const int idx_child = state[node.idx_prop] ? node.idx_true : node.idx_false;
+    if (idx_child >= 0) stack.push_back(idx_child);
+  }
+
+  std::sort(applicable.begin(), applicable.end());
+  return applicable;
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "SuccessorGenerator.GetApplicableActions") {
+  const std::vector<GroundAction>& actions = pddl.Ground();
+  const SuccessorGenerator successor_generator(actions);
+
+  const State state = pddl.NextState(pddl.initial_state(), "pick(box)");
+  for (const State& s : {pddl.initial_state(), state}) {
+    const StateIndex::IndexedState indexed_state =
+        pddl.state_index().GetIndexedState(s);
+    std::vector<size_t> expected;
+    for (const GroundAction& action : actions) {
+      if (action.IsApplicable(indexed_state)) expected.push_back(action.id());
+    }
+    REQUIRE(successor_generator.GetApplicableActions(indexed_state) ==
+            expected);
+  }
+}
+
+}  // namespace symbolic
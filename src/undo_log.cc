@@ -0,0 +1,89 @@
+/**
+ * undo_log.cc
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#include "symbolic/undo_log.h"
+
+#include <exception>      // std::runtime_error
+#include <unordered_set>  // std::unordered_set
+
+#include "symbolic/pddl.h"
+#include "utils/doctest.h"
+
+namespace symbolic {
+
+void UndoLog::Undo(State* state) {
+  if (frames_.empty()) {
+    throw std::runtime_error("UndoLog::Undo(): No frame to undo.");
+  }
+
+  // Revert the changes in reverse order.
+  const size_t idx_begin = frames_.back();
+  for (size_t i = entries_.size(); i > idx_begin; i--) {
+    const Entry& entry = entries_[i - 1];
+    if (entry.is_added) {
+      state->erase(entry.prop);
+    } else {
+      state->insert(entry.prop);
+    }
+  }
+  entries_.resize(idx_begin);
+  frames_.pop_back();
+
+  hash_ = frame_hashes_.back();
+  path_hashes_.erase(path_hashes_.find(hash_));
+  frame_hashes_.pop_back();
+}
+
+bool UndoLog::IsStateRepeated() const {
+  if (path_hashes_.find(hash_) == path_hashes_.end()) return false;
+
+  // Propositions toggled an odd number of times since the current frame.
+  std::unordered_set<Proposition> toggled;
+  size_t idx_entry = entries_.size();
+  for (auto it = frames_.rbegin(); it != frames_.rend(); ++it) {
+    for (; idx_entry > *it; idx_entry--) {
+      const Proposition& prop = entries_[idx_entry - 1].prop;
+      if (toggled.erase(prop) == 0) toggled.insert(prop);
+    }
+    if (toggled.empty()) return true;
+  }
+  return false;
+}
+
+TEST_CASE_FIXTURE(testing::Fixture, "UndoLog.Undo") {
+  const Action& pick = pddl.actions()[0];
+  const Action& place = pddl.actions()[1];
+  const std::vector<Object> hook = {Object(pddl, "hook")};
+  const std::vector<Object> hook_table = {Object(pddl, "hook"),
+                                          Object(pddl, "table")};
+
+  State state = pddl.initial_state();
+  UndoLog log;
+  REQUIRE(pick.ApplyInPlace(hook, &state, &log));
+  REQUIRE(state == pddl.NextState(pddl.initial_state(), "pick(hook)"));
+  REQUIRE(!log.IsStateRepeated());
+
+  // Placing the hook back returns to the initial state.
+  REQUIRE(place.ApplyInPlace(hook_table, &state, &log));
+  REQUIRE(state == pddl.initial_state());
+  REQUIRE(log.IsStateRepeated());
+
+  // Undoing the placement also restores the state hash.
+  Action::Undo(&state, &log);
+  REQUIRE(!log.IsStateRepeated());
+  REQUIRE(place.ApplyInPlace(hook_table, &state, &log));
+  REQUIRE(log.IsStateRepeated());
+  Action::Undo(&state, &log);
+
+  Action::Undo(&state, &log);
+  REQUIRE(state == pddl.initial_state());
+  REQUIRE(log.entries().empty());
+}
+
+}  // namespace symbolic
@@ -26,6 +26,42 @@ struct Fixture {
   Pddl pddl = Pddl("../resources/domain.pddl", "../resources/problem.pddl");
 };
 
+/**
+ * Domain with a static predicate, an action whose add and delete effects
+ * coincide for some arguments, and conditional effects that read each other.
+ */
+struct EffectsFixture {
+  Pddl pddl = Pddl("../resources/effects_domain.pddl",
+                   "../resources/effects_problem.pddl");
+};
+
+/**
+ * Domain with axioms whose effects trigger each other, including an axiom
+ * with a negative context.
+ */
+struct AxiomsFixture {
+  Pddl pddl = Pddl("../resources/axioms_domain.pddl",
+                   "../resources/axioms_problem.pddl");
+};
+
+/**
+ * Domain with recursive derived predicates and a derived predicate defined
+ * through the negation of another one.
+ */
+struct DerivedFixture {
+  Pddl pddl = Pddl("../resources/derived_domain.pddl",
+                   "../resources/derived_problem.pddl");
+};
+
+/**
+ * Domain with derived predicates that depend on each other through negation,
+ * so they can't be stratified.
+ */
+struct DerivedCycleFixture {
+  Pddl pddl = Pddl("../resources/derived_cycle_domain.pddl",
+                   "../resources/derived_cycle_problem.pddl");
+};
+
 }  // namespace testing
 }  // namespace symbolic
 
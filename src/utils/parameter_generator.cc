@@ -9,6 +9,7 @@
 
 #include "symbolic/utils/parameter_generator.h"
 
+#include <algorithm>  // std::remove_if
 #include <exception>  // std::runtime_error
 #include <iostream>   // std::cerr
 
@@ -90,4 +91,20 @@ ParameterGenerator& ParameterGenerator::operator=(
   return *this;
 }
 
+void ParameterGenerator::Restrict(
+    size_t idx_param, const std::function<bool(const Object&)>& Filter) {
+  if (idx_param >= param_types_.size()) return;
+
+  std::vector<Object>& objects = param_types_[idx_param];
+  objects.erase(std::remove_if(objects.begin(), objects.end(),
+                               [&Filter](const Object& object) {
+                                 return !Filter(object);
+                               }),
+                objects.end());
+
+  // Same as a parameter type without objects.
+  if (objects.empty()) param_types_.clear();
+  Base::operator=(Base(Options(param_types_)));
+}
+
 }  // namespace symbolic
@@ -0,0 +1,108 @@
+/**
+ * thread_pool.cc
+ *
+ * Copyright 2026. All Rights Reserved.
+ *
+ * Created: October 16, 2026
+ * Authors: Toki Migimatsu
+ */
+
+#include "symbolic/utils/thread_pool.h"
+
+#include <algorithm>  // std::max
+
+#include "utils/doctest.h"
+
+namespace symbolic {
+
+ThreadPool::ThreadPool(size_t num_threads) {
+  // The calling thread counts as one of the threads.
+  const size_t num_workers = std::max<size_t>(num_threads, 1) - 1;
+  workers_.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; i++) {
+    workers_.emplace_back(&ThreadPool::Work, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    is_terminated_ = true;
+  }
+  cv_start_.notify_all();
+  for (std::thread& worker : workers_) worker.join();
+}
+
+void ThreadPool::Run(size_t num_tasks,
+                     const std::function<void(size_t)>& Task) {
+  if (num_tasks == 0) return;
+
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    Task_ = &Task;
+    num_tasks_ = num_tasks;
+    idx_next_task_ = 0;
+    exception_ = nullptr;
+    num_active_ = workers_.size();
+    idx_batch_++;
+  }
+  cv_start_.notify_all();
+
+  RunTasks();
+
+  // Wait for the workers to leave the batch before Task goes out of scope.
+  std::unique_lock<std::mutex> lock(mtx_);
+  cv_done_.wait(lock, [this]() { return num_active_ == 0; });
+  Task_ = nullptr;
+  if (exception_) std::rethrow_exception(exception_);
+}
+
+void ThreadPool::Work() {
+  size_t idx_batch = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mtx_);
+      cv_start_.wait(lock, [this, idx_batch]() {
+        return is_terminated_ || idx_batch_ != idx_batch;
+      });
+      if (is_terminated_) return;
+      idx_batch = idx_batch_;
+    }
+
+    RunTasks();
+
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      num_active_--;
+    }
+    cv_done_.notify_one();
+  }
+}
+
+void ThreadPool::RunTasks() {
+  for (size_t i = idx_next_task_++; i < num_tasks_; i = idx_next_task_++) {
+    try {
+      (*Task_)(i);
+    } catch (...) {
+      // Skip the remaining tasks.
+      idx_next_task_ = num_tasks_;
+      std::lock_guard<std::mutex> lock(mtx_);
+      if (!exception_) exception_ = std::current_exception();
+    }
+  }
+}
+
+TEST_CASE("ThreadPool.Run") {
+  ThreadPool pool(4);
+  std::vector<size_t> outputs(100, 0);
+  for (size_t batch = 1; batch <= 3; batch++) {
+    pool.Run(outputs.size(), [&outputs, batch](size_t i) {
+      outputs[i] += batch * i;
+    });
+  }
+  for (size_t i = 0; i < outputs.size(); i++) {
+    REQUIRE(outputs[i] == 6 * i);
+  }
+}
+
+}  // namespace symbolic